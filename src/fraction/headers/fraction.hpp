@@ -5,13 +5,35 @@
 #pragma once
 #ifndef FRACTION_FRACTION_HPP_
 
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <istream>
 #include <limits>
-#include <numeric>
 #include <ostream>
 #include <stdexcept>
 #include <type_traits>
 
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L && __has_include(<compare>)
+#include <compare>
+
+#define FRACTION_HAS_THREE_WAY_COMPARISON
+#endif
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <string>
+
+#define FRACTION_HAS_FORMAT
+#endif
+
 ////////////////////////////////////////////////////////////
 // Traits and Limits (Forward declaration)
 ////////////////////////////////////////////////////////////
@@ -23,11 +45,803 @@ struct is_fraction;
 template <class T>
 inline constexpr bool is_fraction_v = is_fraction<T>::value;
 
+/*!
+ * @brief Whether @p T can be the numerator and denominator type of a fraction
+ *
+ * True for all integer types. Other integer like types, like @c bigint, specialize this and @c fraction itself.
+ */
+template <class T>
+struct is_fraction_integer : std::is_integral<T> {};
+
+// Containers and kernels that are friends of fraction
+template <class T, class CHECK_T>
+class fraction_vector;
+
+namespace details {
+template <class T, class CHECK_T>
+class wide_accumulator;
+template <class T, class CHECK_T>
+struct batch_access;
+}  // namespace details
+
+////////////////////////////////////////////////////////////
+// Details
+////////////////////////////////////////////////////////////
+
+namespace details {
+#if defined(__SIZEOF_INT128__) && !defined(FRACTION_NO_INT128)
+#define FRACTION_HAS_INT128
+
+__extension__ typedef unsigned __int128 uint128_t;
+#else
+/*!
+ * @brief Portable unsigned double word integer
+ *
+ * Only used when the compiler doesn't provide @c unsigned @c __int128 (or when @c FRACTION_NO_INT128 is defined). It
+ * implements just enough to serve as the intermediate type of 64 bit fraction arithmetic.
+ */
+class uint128_t {
+ private:
+  std::uint64_t high;
+  std::uint64_t low;
+
+  static constexpr std::uint64_t LOW_MASK{0xFFFFFFFF};
+
+ public:
+  constexpr uint128_t(std::uint64_t low = 0) noexcept : high{0}, low{low} {}
+  constexpr uint128_t(std::uint64_t high, std::uint64_t low) noexcept : high{high}, low{low} {}
+
+  template <class U, class CHECK_U = typename std::enable_if<std::is_integral<U>::value>::type>
+  explicit constexpr operator U() const noexcept {
+    return static_cast<U>(low);
+  }
+
+  friend constexpr bool operator==(const uint128_t& lhs, const uint128_t& rhs) noexcept {
+    return (lhs.high == rhs.high) && (lhs.low == rhs.low);
+  }
+  friend constexpr bool operator!=(const uint128_t& lhs, const uint128_t& rhs) noexcept { return !(lhs == rhs); }
+  friend constexpr bool operator<(const uint128_t& lhs, const uint128_t& rhs) noexcept {
+    return (lhs.high < rhs.high) || ((lhs.high == rhs.high) && (lhs.low < rhs.low));
+  }
+  friend constexpr bool operator>(const uint128_t& lhs, const uint128_t& rhs) noexcept { return rhs < lhs; }
+  friend constexpr bool operator<=(const uint128_t& lhs, const uint128_t& rhs) noexcept { return !(rhs < lhs); }
+  friend constexpr bool operator>=(const uint128_t& lhs, const uint128_t& rhs) noexcept { return !(lhs < rhs); }
+
+  friend constexpr uint128_t operator|(const uint128_t& lhs, const uint128_t& rhs) noexcept {
+    return {lhs.high | rhs.high, lhs.low | rhs.low};
+  }
+  friend constexpr uint128_t operator&(const uint128_t& lhs, const uint128_t& rhs) noexcept {
+    return {lhs.high & rhs.high, lhs.low & rhs.low};
+  }
+
+  friend constexpr uint128_t operator<<(const uint128_t& lhs, int shift) noexcept {
+    if (shift == 0) return lhs;
+    if (shift >= 64) return {lhs.low << (shift - 64), 0};
+
+    return {(lhs.high << shift) | (lhs.low >> (64 - shift)), lhs.low << shift};
+  }
+  friend constexpr uint128_t operator>>(const uint128_t& lhs, int shift) noexcept {
+    if (shift == 0) return lhs;
+    if (shift >= 64) return {0, lhs.high >> (shift - 64)};
+
+    return {lhs.high >> shift, (lhs.low >> shift) | (lhs.high << (64 - shift))};
+  }
+
+  friend constexpr uint128_t operator+(const uint128_t& lhs, const uint128_t& rhs) noexcept {
+    const std::uint64_t low{lhs.low + rhs.low};
+
+    return {lhs.high + rhs.high + (low < lhs.low ? 1 : 0), low};
+  }
+  friend constexpr uint128_t operator-(const uint128_t& lhs, const uint128_t& rhs) noexcept {
+    return {lhs.high - rhs.high - (lhs.low < rhs.low ? 1 : 0), lhs.low - rhs.low};
+  }
+
+  friend constexpr uint128_t operator*(const uint128_t& lhs, const uint128_t& rhs) noexcept {
+    const std::uint64_t lowLow{(lhs.low & LOW_MASK) * (rhs.low & LOW_MASK)};
+    const std::uint64_t lowHigh{(lhs.low & LOW_MASK) * (rhs.low >> 32)};
+    const std::uint64_t highLow{(lhs.low >> 32) * (rhs.low & LOW_MASK)};
+    const std::uint64_t highHigh{(lhs.low >> 32) * (rhs.low >> 32)};
+    const std::uint64_t middle{(lowLow >> 32) + (lowHigh & LOW_MASK) + (highLow & LOW_MASK)};
+
+    return {highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32) + (lhs.high * rhs.low) +
+                (lhs.low * rhs.high),
+            (middle << 32) | (lowLow & LOW_MASK)};
+  }
+
+  static constexpr uint128_t divide(const uint128_t& dividend, const uint128_t& divisor,
+                                    uint128_t& remainder) noexcept {
+    if ((dividend.high == 0) && (divisor.high == 0)) {
+      remainder = dividend.low % divisor.low;
+
+      return dividend.low / divisor.low;
+    }
+
+    uint128_t quotient{};
+    remainder = 0;
+
+    for (int bit = 127; bit >= 0; --bit) {
+      remainder = (remainder << 1) | ((dividend >> bit) & 1);
+      quotient = quotient << 1;
+
+      if (remainder >= divisor) {
+        remainder = remainder - divisor;
+        quotient = quotient | 1;
+      }
+    }
+
+    return quotient;
+  }
+
+  friend constexpr uint128_t operator/(const uint128_t& lhs, const uint128_t& rhs) noexcept {
+    uint128_t remainder{};
+
+    return divide(lhs, rhs, remainder);
+  }
+  friend constexpr uint128_t operator%(const uint128_t& lhs, const uint128_t& rhs) noexcept {
+    uint128_t remainder{};
+    divide(lhs, rhs, remainder);
+
+    return remainder;
+  }
+};
+#endif
+
+template <std::size_t SIZE>
+struct unsigned_of_size;
+
+template <>
+struct unsigned_of_size<2> {
+  typedef std::uint16_t type;
+};
+template <>
+struct unsigned_of_size<4> {
+  typedef std::uint32_t type;
+};
+template <>
+struct unsigned_of_size<8> {
+  typedef std::uint64_t type;
+};
+template <>
+struct unsigned_of_size<16> {
+  typedef uint128_t type;
+};
+
+/// Unsigned type with twice the width of @p T. Products of two values of @p T always fit into it
+template <class T>
+using wide_t = typename unsigned_of_size<2 * sizeof(T)>::type;
+
+/// Magnitude of @p value as an unsigned type. Negating in the unsigned type also works for the minimum of @p T
+template <class T>
+constexpr typename std::make_unsigned<T>::type magnitude(const T& value) noexcept {
+  typedef typename std::make_unsigned<T>::type U;
+
+  if constexpr (std::is_signed<T>::value) {
+    if (value < T{0}) return static_cast<U>(U{0} - static_cast<U>(value));
+  }
+
+  return static_cast<U>(value);
+}
+
+/// Whether @p value can be converted to @p T without changing its value
+template <class T, class T1>
+constexpr bool fitsInto(const T1& value) noexcept {
+  const T narrow{static_cast<T>(value)};
+
+  if (static_cast<T1>(narrow) != value) return false;
+
+  // The round trip alone can't tell a change of sign apart
+  if constexpr (std::is_signed<T1>::value && std::is_unsigned<T>::value)
+    return !(value < T1{0});
+  else if constexpr (std::is_unsigned<T1>::value && std::is_signed<T>::value)
+    return !(narrow < T{0});
+  else
+    return true;
+}
+
+/// Whether @p value is an integer that fits into @p T, so it can take the integer kernels of a fraction of @p T
+template <class T, class D>
+constexpr bool isIntegerOperand(const D& value) noexcept {
+  if constexpr (std::is_integral<D>::value)
+    return fitsInto<T>(value);
+  else
+    return false;
+}
+
+/// Full product of two unsigned values in double width
+template <class U>
+constexpr wide_t<U> multiply(const U& lhs, const U& rhs) noexcept {
+  return static_cast<wide_t<U>>(wide_t<U>{lhs} * wide_t<U>{rhs});
+}
+
+/// Number of trailing zero bits. @p value must not be 0
+template <class U>
+constexpr int countTrailingZeros(const U& value) noexcept {
+  if constexpr (sizeof(U) > sizeof(std::uint64_t)) {
+    const std::uint64_t low{static_cast<std::uint64_t>(value)};
+
+    if (low != 0) return countTrailingZeros(low);
+
+    return 64 + countTrailingZeros(static_cast<std::uint64_t>(value >> 64));
+  } else {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (sizeof(U) <= sizeof(unsigned int))
+      return __builtin_ctz(value);
+    else
+      return __builtin_ctzll(value);
+#else
+    int count{0};
+
+    for (U tmp{value}; (tmp & U{1}) == U{0}; tmp >>= 1) ++count;
+
+    return count;
+#endif
+  }
+}
+
+/// Number of bits needed to represent @p value
+template <class U>
+constexpr int bitWidth(const U& value) noexcept {
+  if constexpr (sizeof(U) > sizeof(std::uint64_t)) {
+    const std::uint64_t high{static_cast<std::uint64_t>(value >> 64)};
+
+    if (high != 0) return 64 + bitWidth(high);
+
+    return bitWidth(static_cast<std::uint64_t>(value));
+  } else {
+#if defined(__GNUC__) || defined(__clang__)
+    return (value == U{0}) ? 0 : (64 - __builtin_clzll(static_cast<std::uint64_t>(value)));
+#else
+    int width{0};
+
+    for (U tmp{value}; tmp != U{0}; tmp >>= 1) ++width;
+
+    return width;
+#endif
+  }
+}
+
+/// @p value * 2^@p exponent. Only multiplies by powers of 2, which is exact as long as the result is a normal number
+template <class D>
+constexpr D scaleByPowerOfTwo(D value, int exponent) noexcept {
+  D factor{1};
+
+  // Square and multiply, so only a handful of steps are needed
+  for (D base{(exponent < 0) ? D{0.5} : D{2}}; exponent != 0; exponent /= 2, base *= base) {
+    if ((exponent % 2) != 0) factor *= base;
+  }
+
+  return value * factor;
+}
+
+/*!
+ * @brief Quotient of two unsigned values, rounded once to the floating point type @p D
+ *
+ * Divides the shifted numerator as integers, so the quotient carries two more bits than the mantissa of @p D and the
+ * remainder tells whether anything below them is set (the sticky bit). That's all that's needed to round correctly
+ * in any direction.
+ *
+ * @param[in] negative   Whether the result is negative. Decides the direction of the directed rounding styles
+ * @param[in] roundStyle How to round. @c std::round_indeterminate rounds to nearest
+ */
+template <class D, class U>
+constexpr D divideRounded(const U& numerator, const U& denominator, bool negative,
+                          std::float_round_style roundStyle) noexcept {
+  typedef wide_t<std::uint64_t> W;
+
+  constexpr int DIGITS{std::numeric_limits<D>::digits};
+  constexpr int PRECISION{DIGITS + 2};
+
+  static_assert(DIGITS <= 64, "The mantissa needs to fit into 64 bits");
+
+  if (numerator == U{0}) return D{0};
+
+  const W wideNumerator{static_cast<std::uint64_t>(numerator)};
+  const W wideDenominator{static_cast<std::uint64_t>(denominator)};
+
+  // Puts the quotient into [2^(PRECISION - 1), 2^(PRECISION + 1))
+  const int shift{PRECISION - (bitWidth(numerator) - bitWidth(denominator))};
+
+  W quotient{};
+  W remainder{};
+
+  // A single division each. The remainder follows from the quotient
+  if (shift < 0) {
+    const W divisor{static_cast<W>(wideDenominator << -shift)};
+
+    quotient = static_cast<W>(wideNumerator / divisor);
+    remainder = static_cast<W>(wideNumerator - quotient * divisor);
+  } else if (bitWidth(numerator) + shift <= 128) {
+    const W dividend{static_cast<W>(wideNumerator << shift)};
+
+    quotient = static_cast<W>(dividend / wideDenominator);
+    remainder = static_cast<W>(dividend - quotient * wideDenominator);
+  } else {
+    // Long division in steps of 64 bits. The remainder is less than the denominator, so it never overflows
+    quotient = static_cast<W>(wideNumerator / wideDenominator);
+    remainder = static_cast<W>(wideNumerator % wideDenominator);
+
+    for (int remaining = shift; remaining > 0; remaining -= 64) {
+      const int step{(remaining < 64) ? remaining : 64};
+      const W dividend{static_cast<W>(remainder << step)};
+
+      quotient = static_cast<W>((quotient << step) | (dividend / wideDenominator));
+      remainder = static_cast<W>(dividend % wideDenominator);
+    }
+  }
+
+  const int dropped{bitWidth(quotient) - DIGITS};
+  const W droppedMask{static_cast<W>((W{1} << dropped) - W{1})};
+  const W droppedBits{static_cast<W>(quotient & droppedMask)};
+  const W half{static_cast<W>(W{1} << (dropped - 1))};
+  const bool inexact{(droppedBits != W{0}) || (remainder != W{0})};
+
+  W mantissa{static_cast<W>(quotient >> dropped)};
+  int exponent{dropped - shift};
+  bool roundUp{false};
+
+  switch (roundStyle) {
+    case std::round_toward_zero:
+      break;
+    case std::round_toward_infinity:
+      roundUp = !negative && inexact;
+      break;
+    case std::round_toward_neg_infinity:
+      roundUp = negative && inexact;
+      break;
+    default:
+      // Ties to even
+      roundUp = (droppedBits > half) ||
+                ((droppedBits == half) && ((remainder != W{0}) || ((mantissa & W{1}) != W{0})));
+      break;
+  }
+
+  if (roundUp) {
+    mantissa = static_cast<W>(mantissa + W{1});
+
+    // Rounded up to the next power of 2
+    if (bitWidth(mantissa) > DIGITS) {
+      mantissa = static_cast<W>(mantissa >> 1);
+      ++exponent;
+    }
+  }
+
+  const D magnitude{scaleByPowerOfTwo(static_cast<D>(static_cast<std::uint64_t>(mantissa)), exponent)};
+
+  return negative ? -magnitude : magnitude;
+}
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define FRACTION_HAS_BUILTIN_BIT_CAST
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1928
+#define FRACTION_HAS_BUILTIN_BIT_CAST
+#endif
+
+/*!
+ * @brief Whether @p value is NaN
+ *
+ * Fast math flags (like @c -Ofast) let the compiler assume there are no NaNs and fold @c value @c != @c value to
+ * @c false. So this looks at the bits instead. Every NaN stays a NaN when converted to @c double, so only the layout of
+ * @c double needs to be known. Without @c __builtin_bit_cast GCC is told not to make that assumption here.
+ */
+template <class D>
+#if !defined(FRACTION_HAS_BUILTIN_BIT_CAST) && defined(__GNUC__) && !defined(__clang__)
+__attribute__((optimize("no-finite-math-only")))
+#endif
+constexpr bool isNaN(const D& value) noexcept {
+#ifdef FRACTION_HAS_BUILTIN_BIT_CAST
+  static_assert(std::numeric_limits<double>::is_iec559, "double needs to be an IEEE 754 binary64");
+
+  constexpr std::uint64_t EXPONENT_MASK{0x7FF0000000000000};
+  constexpr std::uint64_t MANTISSA_MASK{0x000FFFFFFFFFFFFF};
+
+  const std::uint64_t bits{__builtin_bit_cast(std::uint64_t, static_cast<double>(value))};
+
+  return ((bits & EXPONENT_MASK) == EXPONENT_MASK) && ((bits & MANTISSA_MASK) != 0);
+#else
+  return value != value;
+#endif
+}
+
+/*!
+ * @brief Splits a finite positive floating point value into an odd integer mantissa and a power of 2
+ *
+ * Afterwards @p value equals @p mantissa * 2^@p exponent exactly. This only scales by powers of 2, which is exact, so
+ * unlike @c std::frexp it can be used in constant expressions.
+ */
+template <class D>
+constexpr void decompose(D value, std::uint64_t& mantissa, int& exponent) noexcept {
+  static_assert(std::numeric_limits<D>::radix == 2, "Only binary floating point types are supported");
+  static_assert(std::numeric_limits<D>::digits <= 64, "The mantissa needs to fit into 64 bits");
+
+  constexpr D STEP{4294967296.0};
+  constexpr D LOWER{static_cast<D>(std::uint64_t{1} << (std::numeric_limits<D>::digits - 1))};
+  constexpr D UPPER{LOWER * D{2}};
+
+  exponent = 0;
+
+  // Scale into [LOWER, UPPER), where the value is an integer
+  for (; value < LOWER / STEP; exponent -= 32) value *= STEP;
+  for (; value < LOWER; --exponent) value *= D{2};
+  for (; value >= UPPER * STEP; exponent += 32) value /= STEP;
+  for (; value >= UPPER; ++exponent) value /= D{2};
+
+  mantissa = static_cast<std::uint64_t>(value);
+
+  const int shift{countTrailingZeros(mantissa)};
+
+  mantissa >>= shift;
+  exponent += shift;
+}
+
+/*!
+ * @brief Closest fraction to @p numerator / @p denominator with a denominator of at most @p maxDenominator
+ *
+ * Walks the Stern-Brocot tree along the continued fraction. Once the next convergent exceeds @p maxDenominator, the
+ * answer is either the last convergent or the largest semiconvergent that still fits. On a tie the convergent wins.
+ * Same as Python's @c Fraction.limit_denominator, which uses the continued fraction of the signed value, so ties of
+ * negative values can end up on the other side than those of their magnitude.
+ *
+ * All values are magnitudes, with @p negative giving the sign of the value. @p numerator / @p denominator must be
+ * reduced. The result is reduced as well.
+ */
+template <class U>
+constexpr void limitDenominator(U numerator, U denominator, const U& maxDenominator, bool negative,
+                                U& resultNumerator, U& resultDenominator) noexcept {
+  if (denominator <= maxDenominator) {
+    resultNumerator = numerator;
+    resultDenominator = denominator;
+
+    return;
+  }
+
+  if (negative) {
+    // -n/d = -(a + 1) + (d - r)/d. So the continued fraction of the signed value is the one of the positive fraction
+    // (d - r)/d, which is reduced since gcd(d - r, d) = gcd(r, d) = 1, shifted by -(a + 1)
+    const U integer{static_cast<U>(numerator / denominator)};
+    const U remainder{static_cast<U>(numerator - integer * denominator)};
+
+    limitDenominator(static_cast<U>(denominator - remainder), denominator, maxDenominator, false, resultNumerator,
+                     resultDenominator);
+
+    // The limited fractional part is at most 1, so the magnitude (a + 1) - p/q is (a*q + (q - p))/q. It's no larger
+    // than the original numerator
+    resultNumerator = static_cast<U>(integer * resultDenominator + static_cast<U>(resultDenominator - resultNumerator));
+
+    return;
+  }
+
+  const U originalDenominator{denominator};
+
+  U p0{0};
+  U q0{1};
+  U p1{1};
+  U q1{0};
+
+  // The convergents never exceed the original numerator and denominator, so nothing here can overflow
+  while (true) {
+    const U digit{static_cast<U>(numerator / denominator)};
+    const U q2{static_cast<U>(q0 + digit * q1)};
+
+    if (q2 > maxDenominator) break;
+
+    const U p2{static_cast<U>(p0 + digit * p1)};
+
+    p0 = p1;
+    q0 = q1;
+    p1 = p2;
+    q1 = q2;
+
+    const U remainder{static_cast<U>(numerator - digit * denominator)};
+
+    numerator = denominator;
+    denominator = remainder;
+  }
+
+  const U steps{static_cast<U>((maxDenominator - q0) / q1)};
+  const U semiconvergentDenominator{static_cast<U>(q0 + steps * q1)};
+
+  // The two candidates are 1 / (q1 * semiconvergentDenominator) apart and the convergent is
+  // denominator / (q1 * originalDenominator) away from the value
+  if (denominator <= static_cast<U>(static_cast<U>(originalDenominator / U{2}) / semiconvergentDenominator)) {
+    resultNumerator = p1;
+    resultDenominator = q1;
+  } else {
+    resultNumerator = static_cast<U>(p0 + steps * p1);
+    resultDenominator = semiconvergentDenominator;
+  }
+}
+
+/// GCD algorithms that can be selected through @c gcd_algorithm_for
+enum class gcd_algorithm {
+  /// Classic Euclidean algorithm. One division per step, which is cheap for small types
+  euclid,
+  /// Stein's binary algorithm. Only uses shifts, subtractions and trailing zero counts
+  binary
+};
+
+/*!
+ * @brief Selects the GCD algorithm per unsigned integer type
+ *
+ * Hardware division of small types is fast, while 32 bit and larger divisions take tens of cycles each. The binary
+ * algorithm also avoids the very slow division routines of double word types. Specialize this to change the choice.
+ *
+ * @tparam U Unsigned integer type
+ */
+template <class U>
+struct gcd_algorithm_for
+    : std::integral_constant<gcd_algorithm, (sizeof(U) < 4) ? gcd_algorithm::euclid : gcd_algorithm::binary> {};
+
+template <gcd_algorithm ALGORITHM>
+struct gcd_kernel;
+
+template <>
+struct gcd_kernel<gcd_algorithm::euclid> {
+  template <class U>
+  static constexpr U gcd(U lhs, U rhs) noexcept {
+    constexpr U ZERO{0};
+
+    while (rhs != ZERO) {
+      const U tmp{static_cast<U>(lhs % rhs)};
+      lhs = rhs;
+      rhs = tmp;
+    }
+
+    return lhs;
+  }
+};
+
+template <>
+struct gcd_kernel<gcd_algorithm::binary> {
+  template <class U>
+  static constexpr U gcd(U lhs, U rhs) noexcept {
+    constexpr U ZERO{0};
+
+    if (lhs == ZERO) return rhs;
+    if (rhs == ZERO) return lhs;
+
+    const int shift{countTrailingZeros(static_cast<U>(lhs | rhs))};
+    lhs = static_cast<U>(lhs >> countTrailingZeros(lhs));
+
+    // Both values are odd at the start of each iteration, so their difference is even and non zero. The min/max
+    // selection compiles to conditional moves instead of a hard to predict branch
+    do {
+      rhs = static_cast<U>(rhs >> countTrailingZeros(rhs));
+
+      const U smaller{lhs < rhs ? lhs : rhs};
+      rhs = static_cast<U>((lhs < rhs ? rhs : lhs) - smaller);
+      lhs = smaller;
+    } while (rhs != ZERO);
+
+    return static_cast<U>(lhs << shift);
+  }
+};
+
+/// Greatest common divisor of two unsigned values, using the algorithm selected by @c gcd_algorithm_for
+template <class U>
+constexpr U gcd(const U& lhs, const U& rhs) noexcept {
+  return gcd_kernel<gcd_algorithm_for<U>::value>::gcd(lhs, rhs);
+}
+
+constexpr bool isDigit(char character) noexcept { return (character >= '0') && (character <= '9'); }
+
+/// @p value = @p value * 10 + @p digit. Returns @c false instead when that overflows
+template <class U>
+constexpr bool appendDigit(U& value, unsigned int digit) noexcept {
+  constexpr U MAX{static_cast<U>(U{0} - U{1})};
+  constexpr U LIMIT{static_cast<U>(MAX / U{10})};
+
+  if (value > LIMIT) return false;
+
+  value = static_cast<U>(value * U{10});
+
+  if (value > static_cast<U>(MAX - static_cast<U>(digit))) return false;
+
+  value = static_cast<U>(value + static_cast<U>(digit));
+
+  return true;
+}
+
+/*!
+ * @brief Reads decimal digits into @p value
+ *
+ * Zeros are only counted in @p zeros and multiplied in once another digit follows, so trailing zeros never overflow.
+ * The caller scales by the remaining @p zeros itself. All digits are consumed, even once @p overflow is set.
+ *
+ * @returns Pointer to the first character that isn't a digit
+ */
+template <class U>
+constexpr const char* parseDigits(const char* first, const char* last, U& value, std::ptrdiff_t& zeros,
+                                  bool& overflow) noexcept {
+  for (; (first != last) && isDigit(*first); ++first) {
+    if (*first == '0') {
+      ++zeros;
+
+      continue;
+    }
+
+    for (; !overflow && (zeros > 0); --zeros) overflow = !appendDigit(value, 0);
+
+    if (!overflow) overflow = !appendDigit(value, static_cast<unsigned int>(*first - '0'));
+  }
+
+  return first;
+}
+
+/// @p value * 10^@p exponent, as long as it stays at or below @p limit. Returns @c false instead
+template <class U>
+constexpr bool scaleByPowerOfTen(U& value, std::ptrdiff_t exponent, const U& limit) noexcept {
+  const U factorLimit{static_cast<U>(limit / U{10})};
+
+  for (; exponent > 0; --exponent) {
+    if (value > factorLimit) return false;
+
+    value = static_cast<U>(value * U{10});
+  }
+
+  return value <= limit;
+}
+
+/// All two digit numbers, so formatting needs only one division per two digits
+inline constexpr char digitPairs[]{
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"};
+
+/// Number of decimal digits of @p value. 0 has one digit
+template <class U>
+constexpr int countDigits(U value) noexcept {
+  int digits{1};
+
+  for (; value >= 10000U; value = static_cast<U>(value / 10000U)) digits += 4;
+  for (; value >= U{10}; value = static_cast<U>(value / U{10})) ++digits;
+
+  return digits;
+}
+
+/// Writes @p value in decimal. Returns @c nullptr instead when it doesn't fit between @p first and @p last
+template <class U>
+constexpr char* writeDigits(char* first, char* last, U value) noexcept {
+  const int digits{countDigits(value)};
+
+  if ((last - first) < digits) return nullptr;
+
+  char* const end{first + digits};
+  char* position{end};
+
+  for (; value >= U{100}; value = static_cast<U>(value / U{100})) {
+    const std::size_t index{static_cast<std::size_t>(value % U{100}) * 2};
+
+    *--position = digitPairs[index + 1];
+    *--position = digitPairs[index];
+  }
+
+  if (value >= U{10}) {
+    const std::size_t index{static_cast<std::size_t>(value) * 2};
+
+    *--position = digitPairs[index + 1];
+    *--position = digitPairs[index];
+  } else {
+    *--position = static_cast<char>('0' + static_cast<int>(value));
+  }
+
+  return end;
+}
+
+/// Next decimal digit of @p remainder / @p denominator. @p remainder has to be less than @p denominator
+template <class U>
+constexpr int nextDecimalDigit(U& remainder, const U& denominator) noexcept {
+  // The double width type is only needed when 10 * remainder may overflow
+  if (denominator <= static_cast<U>(static_cast<U>(~U{0}) / U{10})) {
+    remainder = static_cast<U>(remainder * U{10});
+
+    const U digit{static_cast<U>(remainder / denominator)};
+    remainder = static_cast<U>(remainder - (digit * denominator));
+
+    return static_cast<int>(digit);
+  } else {
+    const wide_t<U> scaled{static_cast<wide_t<U>>(wide_t<U>{remainder} * wide_t<U>{10})};
+    const U digit{static_cast<U>(scaled / wide_t<U>{denominator})};
+    remainder = static_cast<U>(scaled - (wide_t<U>{digit} * wide_t<U>{denominator}));
+
+    return static_cast<int>(digit);
+  }
+}
+
+/// Maps the characters a fraction literal can consist of to @c char. Everything else becomes @c '\0'
+template <class charT>
+constexpr char narrowLiteralCharacter(charT character) noexcept {
+  if ((character >= charT{'0'}) && (character <= charT{'9'})) return static_cast<char>('0' + (character - charT{'0'}));
+
+  for (const char candidate : {'-', '+', '.', '/', 'e', 'E'}) {
+    if (character == charT{candidate}) return candidate;
+  }
+
+  return '\0';
+}
+
+/*!
+ * @brief Whether @p next can extend the literal in @p buffer
+ *
+ * Streams can't put back more than one character, so extraction has to stop at the first character that can't be
+ * part of a fraction literal. This follows the grammar of @c fraction_from_chars closely enough for that.
+ */
+constexpr bool continuesLiteral(const char* buffer, std::size_t length, char next) noexcept {
+  bool slash{false};
+  bool dot{false};
+  bool exponent{false};
+  bool digit{false};
+
+  for (std::size_t i = 0; i < length; ++i) {
+    slash |= buffer[i] == '/';
+    dot |= buffer[i] == '.';
+    exponent |= (buffer[i] == 'e') || (buffer[i] == 'E');
+    digit |= isDigit(buffer[i]);
+  }
+
+  const char previous{(length == 0) ? '\0' : buffer[length - 1]};
+  const bool afterExponent{(previous == 'e') || (previous == 'E')};
+
+  switch (next) {
+    case '\0':
+      return false;
+    case '-':
+      return (length == 0) || afterExponent;
+    case '+':
+      return afterExponent;
+    case '/':
+      return !slash && !dot && !exponent && isDigit(previous);
+    case '.':
+      return !slash && !dot && !exponent;
+    case 'e':
+    case 'E':
+      return !slash && !exponent && digit && (isDigit(previous) || (previous == '.'));
+    default:
+      return true;
+  }
+}
+
+/// Finalizer of MurmurHash3. Every input bit affects every output bit
+constexpr std::uint64_t mixHash(std::uint64_t value) noexcept {
+  value ^= value >> 33;
+  value *= 0xFF51AFD7ED558CCDULL;
+  value ^= value >> 33;
+  value *= 0xC4CEB9FE1A85EC53ULL;
+  value ^= value >> 33;
+
+  return value;
+}
+
+/// Folds the bits of @p value into 64 bits
+template <class T>
+constexpr std::uint64_t hashWord(const T& value) noexcept {
+  typedef typename std::make_unsigned<T>::type unsigned_type;
+
+  const unsigned_type bits{static_cast<unsigned_type>(value)};
+
+  if constexpr (sizeof(unsigned_type) <= sizeof(std::uint64_t))
+    return static_cast<std::uint64_t>(bits);
+  else
+    return static_cast<std::uint64_t>(bits) ^ mixHash(static_cast<std::uint64_t>(bits >> 64));
+}
+
+/*!
+ * @brief Hashes a reduced fraction
+ *
+ * Multiplying the numerator by an odd constant before combining keeps n/d and d/n apart, and the finalizer spreads
+ * small numerators and denominators over all bits. So nearby fractions land in different buckets.
+ */
+template <class T>
+constexpr std::size_t hashFraction(const T& numerator, const T& denominator) noexcept {
+  return static_cast<std::size_t>(mixHash((hashWord(numerator) * 0x9E3779B97F4A7C15ULL) ^ hashWord(denominator)));
+}
+}  // namespace details
+
 ////////////////////////////////////////////////////////////
 // Declarations
 ////////////////////////////////////////////////////////////
 
-template <class T = std::int64_t, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+template <class T = std::int64_t, class CHECK_T = typename std::enable_if<is_fraction_integer<T>::value>::type>
 class fraction {
  public:
   // Flags
@@ -41,6 +855,12 @@ class fraction {
   static constexpr T ZERO{0};
   static constexpr T ONE{1};
 
+  typedef typename std::make_unsigned<T>::type unsigned_type;
+  typedef details::wide_t<T> wide_type;
+
+  /// Selects the constructor that takes a numerator and denominator that are already reduced
+  struct reduced_tag {};
+
   // Fields
   T numerator;
   T denominator;
@@ -52,6 +872,15 @@ class fraction {
   /// We wanna be friends with ourselves
   template <class T1, class CHECK_T1>
   friend class fraction;
+  /// Stores reduced fractions column wise and rebuilds them without reducing again
+  template <class T1, class CHECK_T1>
+  friend class fraction_vector;
+  /// Builds its reduced results without reducing again
+  template <class T1, class CHECK_T1>
+  friend class details::wide_accumulator;
+  /// Lets the batch conversions store results that are reduced already
+  template <class T1, class CHECK_T1>
+  friend struct details::batch_access;
 
   // Fraction Contrsuctor
   constexpr fraction(const T& numerator = ZERO, const T& denominator = ONE);
@@ -66,7 +895,11 @@ class fraction {
    * This constructor accepts a floating point value and optionally a precision, which defines how much difference
    * between the value and fraction is allowed.
    *
-   * The underlying algorithm is explained here: http://jonisalonen.com/2012/converting-decimal-numbers-to-ratios/
+   * The value is split into an integer mantissa and a power of 2 first. Integers, and with the default precision
+   * values whose exact denominator is small enough that no shorter fraction rounds to the same value, are built from
+   * that directly. All other values use continued fractions, which are explained here:
+   * http://jonisalonen.com/2012/converting-decimal-numbers-to-ratios/ \n
+   * If no fraction of @p T meets the precision, the last convergent that fits is used.
    *
    * @tparam    T
    * @tparam    CHECK_T  Used for checking if @p T is an integer type
@@ -76,7 +909,8 @@ class fraction {
    * @param[in] precison Defines how much the value of the fraction is allowed to deviate from @p value. By default it's
    * 0.0, so not at all
    *
-   * @throws std::invalid_argument when @p T is @c unsigned and @p value is negative.
+   * @throws std::invalid_argument when @p T is @c unsigned and @p value is negative, or when @p value is NaN.
+   * @throws std::overflow_error when @p value is outside of the range of @p T.
    */
   template <class D,
             class CHECK_D = typename std::enable_if<std::is_floating_point<D>::value && !is_fraction<D>::value>::type>
@@ -87,9 +921,43 @@ class fraction {
 
   constexpr fraction(const fraction<T, CHECK_T>& copy) noexcept = default;
 
+ private:
+  /*!
+   * @brief Reduced constructor
+   *
+   * Takes over @p numerator and @p denominator as is. They have to be coprime already and @p denominator has to be
+   * positive. Used wherever the result is known to be reduced, so the gcd can be skipped.
+   */
+  constexpr fraction(const T& numerator, const T& denominator, reduced_tag) noexcept;
+
+ public:
+
   constexpr const T& getNumerator() const noexcept;
   constexpr const T& getDenominator() const noexcept;
 
+  /*!
+   * @brief Closest fraction with a denominator of at most @p maxDenominator
+   *
+   * Uses the semiconvergents of the continued fraction, like Python's @c Fraction.limit_denominator, and breaks ties
+   * the same way. That picks the convergent of the signed value, so a tie isn't always decided the same for a value
+   * and its negation. Like 1/2 and -1/2 with a @p maxDenominator of 1 become 0 and -1.
+   *
+   * @throws std::invalid_argument when @p maxDenominator is less than 1.
+   */
+  constexpr fraction<T, CHECK_T> limitDenominator(const T& maxDenominator) const;
+
+  /*!
+   * @brief Closest fraction to a floating point value with a denominator of at most @p maxDenominator
+   *
+   * Works on the exact value of @p value, so unlike the floating point constructor no rounding errors creep in.
+   *
+   * @throws std::invalid_argument when @p maxDenominator is less than 1, when @p T is @c unsigned and @p value is
+   * negative, or when @p value is NaN.
+   * @throws std::overflow_error when the result is outside of the range of @p T.
+   */
+  template <class D, class CHECK_D = typename std::enable_if<std::is_floating_point<D>::value>::type>
+  static constexpr fraction<T, CHECK_T> limitDenominator(const D& value, const T& maxDenominator);
+
   // Assignment operators
   constexpr fraction<T, CHECK_T>& operator=(const fraction<T, CHECK_T>& rhs) noexcept = default;
 
@@ -148,9 +1016,22 @@ class fraction {
   template <class D, class T1, class CHECK_T1, class CHECK_D>
   friend constexpr bool operator>=(const D& lhs, const fraction<T1, CHECK_T1>& rhs);
 
+#ifdef FRACTION_HAS_THREE_WAY_COMPARISON
+  template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
+  friend constexpr std::strong_ordering operator<=>(const fraction<T1, CHECK_T1>& lhs,
+                                                    const fraction<T2, CHECK_T2>& rhs);
+  template <class T1, class CHECK_T1>
+  friend constexpr std::strong_ordering operator<=>(const fraction<T1, CHECK_T1>& lhs,
+                                                    const fraction<T1, CHECK_T1>& rhs) noexcept;
+  template <class T1, class CHECK_T1, class D, class CHECK_D>
+  friend constexpr std::strong_ordering operator<=>(const fraction<T1, CHECK_T1>& lhs, const D& rhs);
+#endif
+
   // Arithmetic operators
 
   constexpr fraction<T, CHECK_T>& operator+=(const fraction<T, CHECK_T>& rhs);
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  constexpr fraction<T, CHECK_T>& operator+=(const D& rhs);
 
   template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
   friend constexpr fraction<COMMON, CHECK_COMMON> operator+(const fraction<T1, CHECK_T1>& lhs,
@@ -164,6 +1045,8 @@ class fraction {
   friend constexpr fraction<T1, CHECK_T1> operator+(const D& lhs, const fraction<T1, CHECK_T1>& rhs);
 
   constexpr fraction<T, CHECK_T>& operator-=(const fraction<T, CHECK_T>& rhs);
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  constexpr fraction<T, CHECK_T>& operator-=(const D& rhs);
 
   template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
   friend constexpr fraction<COMMON, CHECK_COMMON> operator-(const fraction<T1, CHECK_T1>& lhs,
@@ -177,6 +1060,8 @@ class fraction {
   friend constexpr fraction<T1, CHECK_T1> operator-(const D& lhs, const fraction<T1, CHECK_T1>& rhs);
 
   constexpr fraction<T, CHECK_T>& operator*=(const fraction<T, CHECK_T>& rhs);
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  constexpr fraction<T, CHECK_T>& operator*=(const D& rhs);
 
   template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
   friend constexpr fraction<COMMON, CHECK_COMMON> operator*(const fraction<T1, CHECK_T1>& lhs,
@@ -190,6 +1075,8 @@ class fraction {
   friend constexpr fraction<T1, CHECK_T1> operator*(const D& lhs, const fraction<T1, CHECK_T1>& rhs);
 
   constexpr fraction<T, CHECK_T>& operator/=(const fraction<T, CHECK_T>& rhs);
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  constexpr fraction<T, CHECK_T>& operator/=(const D& rhs);
 
   template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
   friend constexpr fraction<COMMON, CHECK_COMMON> operator/(const fraction<T1, CHECK_T1>& lhs,
@@ -202,10 +1089,24 @@ class fraction {
   template <class D, class T1, class CHECK_T1, class CHECK_D>
   friend constexpr fraction<T1, CHECK_T1> operator/(const D& lhs, const fraction<T1, CHECK_T1>& rhs);
 
+  /*!
+   * @brief Adds 1
+   *
+   * @throws std::overflow_error when the result doesn't fit into @p T, like @c operator+= does. Unsigned types throw
+   * as well instead of wrapping around.
+   */
   constexpr fraction<T, CHECK_T>& operator++();
+  /// @copydoc operator++()
   constexpr fraction<T, CHECK_T> operator++(int);
 
+  /*!
+   * @brief Subtracts 1
+   *
+   * @throws std::overflow_error when the result doesn't fit into a signed @p T. Unsigned types wrap around below 0,
+   * like with @c operator-=.
+   */
   constexpr fraction<T, CHECK_T>& operator--();
+  /// @copydoc operator--()
   constexpr fraction<T, CHECK_T> operator--(int);
 
   template <class T1, class CHECK_T1>
@@ -214,22 +1115,117 @@ class fraction {
   friend constexpr fraction<T1, CHECK_T1> operator-(const fraction<T1, CHECK_T1>& rhs);
 
   // Conversion operators
+  /*!
+   * @brief Converts to an arithmetic type
+   *
+   * Integer types get the quotient rounded toward zero. Floating point types get the correctly rounded quotient, see
+   * @c toFloatingPoint.
+   */
   template <class D,
             class CHECK_D = typename std::enable_if<std::is_arithmetic<D>::value && !is_fraction<D>::value>::type>
   constexpr operator D() const noexcept;
 
+  /*!
+   * @brief Converts to a floating point type with a single rounding
+   *
+   * When numerator and denominator are both exactly representable in @p D, a floating point division rounds correctly
+   * to nearest already. Otherwise the quotient is computed as integers with enough extra bits to round it correctly.
+   *
+   * @tparam    D          Floating point type to convert to
+   * @param[in] roundStyle How to round the quotient. @c std::round_indeterminate rounds to nearest as well
+   */
+  template <class D, class CHECK_D = typename std::enable_if<std::is_floating_point<D>::value>::type>
+  constexpr D toFloatingPoint(std::float_round_style roundStyle = std::round_to_nearest) const noexcept;
+
   // Stream operators
   template <class charT, class traits, class T1, class CHECK_T1>
   friend std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, traits>& ostream,
                                                        const fraction<T1, CHECK_T1>& fraction);
 
-  // TODO: operator>> (maybe)
+  /*!
+   * @brief Parses a fraction without allocating, throwing or looking at the locale
+   *
+   * Works like @c std::from_chars. Accepted are an optional @c '-' (only for signed @p T1), followed by either
+   * @c n/d, a plain integer or a decimal like @c 12.375 with an optional exponent like @c 1.5e-3. The decimal is
+   * converted exactly. Leading whitespace and @c '+' are not accepted.
+   *
+   * @returns @c ptr points past the parsed characters and @c ec is empty on success. @c ec is
+   * @c std::errc::invalid_argument (and @c ptr is @p first) if no fraction starts at @p first or the denominator is 0,
+   * and @c std::errc::result_out_of_range if the reduced value doesn't fit into @p T1. @p value is only changed on
+   * success.
+   */
+  template <class T1, class CHECK_T1>
+  friend constexpr std::from_chars_result fraction_from_chars(const char* first, const char* last,
+                                                              fraction<T1, CHECK_T1>& value) noexcept;
+
+  /// Reads the characters of a fraction literal into a buffer and parses it with @c fraction_from_chars
+  template <class charT, class traits, class T1, class CHECK_T1>
+  friend std::basic_istream<charT, traits>& operator>>(std::basic_istream<charT, traits>& istream,
+                                                       fraction<T1, CHECK_T1>& fraction);
 
  private:
   constexpr void reduce();
 
   template <class T1, class CHECK_T1 = typename std::enable_if<std::is_integral<T1>::value>::type>
   static constexpr void reduce(T1& numerator, T1& denominator);
+
+  static constexpr bool isNegative(const T& value) noexcept;
+
+  /*!
+   * @brief Three way comparison that all relational operators are built on
+   *
+   * Decides on the signs first, then on equal denominators and otherwise with a single cross multiplication in
+   * @c wide_type, which can't overflow.
+   *
+   * @returns A negative value if @p lhs < @p rhs, 0 if they are equal and a positive value if @p lhs > @p rhs.
+   */
+  static constexpr int compare(const fraction<T, CHECK_T>& lhs, const fraction<T, CHECK_T>& rhs) noexcept;
+
+  constexpr void add(const fraction<T, CHECK_T>& rhs, bool subtract);
+
+  /*!
+   * @brief Adds an integer in place
+   *
+   * a/b + k = (a + k*b)/b is reduced already, since gcd(a + k*b, b) = gcd(a, b) = 1. So no gcd is needed at all.
+   *
+   * @param[in] value    The integer to add
+   * @param[in] subtract Subtract @p value instead
+   * @param[in] negate   Negate this fraction before adding, which turns the result into k - a/b
+   */
+  constexpr void addInteger(const T& value, bool subtract, bool negate);
+
+  /// a/b * k only needs gcd(k, b) cancelled, since a and b are coprime already
+  constexpr void multiplyInteger(const T& value);
+
+  /*!
+   * @brief Divides by an integer in place
+   *
+   * a/b / k only needs gcd(a, k) cancelled, since a and b are coprime already.
+   *
+   * @param[in] value      The integer to divide by
+   * @param[in] reciprocal Divide @p value by this fraction instead, which turns the result into k / (a/b)
+   *
+   * @throws std::invalid_argument when the divisor is 0.
+   */
+  constexpr void divideInteger(const T& value, bool reciprocal);
+
+  /// Same as @c compare, but against an integer. Takes a single multiplication
+  static constexpr int compareInteger(const fraction<T, CHECK_T>& lhs, const T& value) noexcept;
+
+  /*!
+   * @brief Stores a result given in double width that is already reduced
+   *
+   * All arithmetic operators compute their intermediate products in @c wide_type, so they can't overflow. The result
+   * only needs to fit into @p T.
+   *
+   * @param[in] negative    Whether the result is negative
+   * @param[in] numerator   Magnitude of the numerator
+   * @param[in] denominator Magnitude of the denominator
+   *
+   * @throws std::invalid_argument when @p denominator is 0.
+   * @throws std::overflow_error when the result doesn't fit into @p T.
+   */
+  constexpr void assignReduced(bool negative, const wide_type& numerator, const wide_type& denominator);
 };
 
 ////////////////////////////////////////////////////////////
@@ -267,9 +1263,6 @@ template <
     class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON = typename std::common_type<T1, T2>::type,
     class CHECK_COMMON = typename std::enable_if<!std::is_same<T1, T2>::value && std::is_integral<COMMON>::value>::type>
 constexpr bool operator<(const fraction<T1, CHECK_T1>& lhs, const fraction<T2, CHECK_T2>& rhs);
-/**
- * Taken and adapted from https://stackoverflow.com/a/13334474/1996022
- */
 template <class T1, class CHECK_T1>
 constexpr bool operator<(const fraction<T1, CHECK_T1>& lhs, const fraction<T1, CHECK_T1>& rhs) noexcept;
 template <class T1, class CHECK_T1, class D,
@@ -318,6 +1311,19 @@ template <class D, class T1, class CHECK_T1,
           class CHECK_D = typename std::enable_if<std::is_arithmetic<D>::value && !is_fraction<D>::value>::type>
 constexpr bool operator>=(const D& lhs, const fraction<T1, CHECK_T1>& rhs);
 
+#ifdef FRACTION_HAS_THREE_WAY_COMPARISON
+template <
+    class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON = typename std::common_type<T1, T2>::type,
+    class CHECK_COMMON = typename std::enable_if<!std::is_same<T1, T2>::value && std::is_integral<COMMON>::value>::type>
+constexpr std::strong_ordering operator<=>(const fraction<T1, CHECK_T1>& lhs, const fraction<T2, CHECK_T2>& rhs);
+template <class T1, class CHECK_T1>
+constexpr std::strong_ordering operator<=>(const fraction<T1, CHECK_T1>& lhs,
+                                           const fraction<T1, CHECK_T1>& rhs) noexcept;
+template <class T1, class CHECK_T1, class D,
+          class CHECK_D = typename std::enable_if<std::is_arithmetic<D>::value && !is_fraction<D>::value>::type>
+constexpr std::strong_ordering operator<=>(const fraction<T1, CHECK_T1>& lhs, const D& rhs);
+#endif
+
 // Arithmetic operators
 template <
     class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON = typename std::common_type<T1, T2>::type,
@@ -384,6 +1390,44 @@ constexpr fraction<T1, CHECK_T1> operator-(const fraction<T1, CHECK_T1>& rhs);
 template <class charT, class traits, class T1, class CHECK_T1>
 std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, traits>& ostream,
                                               const fraction<T1, CHECK_T1>& fraction);
+template <class charT, class traits, class T1, class CHECK_T1>
+std::basic_istream<charT, traits>& operator>>(std::basic_istream<charT, traits>& istream,
+                                              fraction<T1, CHECK_T1>& fraction);
+
+// Parsing and formatting
+template <class T1, class CHECK_T1>
+constexpr std::from_chars_result fraction_from_chars(const char* first, const char* last,
+                                                     fraction<T1, CHECK_T1>& value) noexcept;
+
+/// How @c to_chars writes a fraction
+enum class fraction_chars_format {
+  /// @c n/d, the same as @c operator<<
+  fraction,
+  /// @c n/d, but just @c n when the denominator is 1
+  compact,
+  /// Integer part and proper fraction, like @c -3 @c 1/2. Integers and values between -1 and 1 only write one of them
+  mixed,
+  /// Decimal with a fixed number of digits after the point, rounded to nearest with ties to even
+  fixed
+};
+
+/*!
+ * @brief Formats a fraction without streams, like @c std::to_chars
+ *
+ * Digits are written two at a time from a table, and the digits of @c fraction_chars_format::fixed are computed
+ * exactly by long division, so no precision gets lost on the way through a floating point type.
+ *
+ * @param[in] format    How to write the fraction
+ * @param[in] precision Digits after the decimal point. Only used by @c fraction_chars_format::fixed. Negative values
+ * mean 6, like @c printf
+ *
+ * @returns @c ptr points past the written characters and @c ec is empty on success. Otherwise @c ptr is @p last and
+ * @c ec is @c std::errc::value_too_large, while the contents of the range are unspecified.
+ */
+template <class T1, class CHECK_T1>
+constexpr std::to_chars_result to_chars(char* first, char* last, const fraction<T1, CHECK_T1>& value,
+                                        fraction_chars_format format = fraction_chars_format::fraction,
+                                        int precision = -1) noexcept;
 
 ////////////////////////////////////////////////////////////
 // Traits and Limits
@@ -404,6 +1448,17 @@ struct is_signed<fraction<T, CHECK_T>> : integral_constant<bool, fraction<T, CHE
 template <class T, class CHECK_T>
 struct is_unsigned<fraction<T, CHECK_T>> : integral_constant<bool, fraction<T, CHECK_T>::is_unsigned> {};
 
+/*!
+ * @brief Hashes fractions by their reduced numerator and denominator
+ *
+ * Fractions are always reduced, so equal fractions hash equally. Use @c fraction_hash to also look up unreduced
+ * @c lazy_fraction values.
+ */
+template <class T, class CHECK_T>
+struct hash<fraction<T, CHECK_T>> {
+  constexpr size_t operator()(const fraction<T, CHECK_T>& value) const noexcept;
+};
+
 template <class T1, class CHECK_T1, class T2, class CHECK_T2>
 struct common_type<fraction<T1, CHECK_T1>, fraction<T2, CHECK_T2>> {
   typedef fraction<typename std::common_type<T1, T2>::type> type;
@@ -448,6 +1503,33 @@ class numeric_limits<fraction<T, CHECK_T>> {
   static constexpr bool tinyness_before = false;
   static constexpr float_round_style round_style = round_to_nearest;
 };
+
+#ifdef FRACTION_HAS_FORMAT
+/*!
+ * @brief Formats fractions with @c std::format, using @c to_chars
+ *
+ * The format spec is @c [[fill]align][width][.precision][type], like the one of the built in types. The type selects
+ * the @c fraction_chars_format: none for @c n/d, @c c for compact, @c m for mixed and @c f for fixed. A precision is
+ * only allowed with @c f. Fractions are right aligned by default, like numbers. The fill is a single code unit.
+ *
+ * Sign, @c # and @c 0 options and widths or precisions given as arguments (@c {}) throw a @c std::format_error.
+ */
+template <class T, class CHECK_T, class charT>
+struct formatter<fraction<T, CHECK_T>, charT> {
+ private:
+  fraction_chars_format charsFormat{fraction_chars_format::fraction};
+  int precision{-1};
+  charT fill{charT{' '}};
+  charT align{charT{'>'}};
+  std::size_t width{0};
+
+ public:
+  constexpr typename basic_format_parse_context<charT>::iterator parse(basic_format_parse_context<charT>& context);
+
+  template <class FormatContext>
+  typename FormatContext::iterator format(const fraction<T, CHECK_T>& value, FormatContext& context) const;
+};
+#endif
 }  // namespace std
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -481,7 +1563,7 @@ inline constexpr fraction<T, CHECK_T>::fraction(T1 numerator, T1 denominator) :
   this->denominator = static_cast<T>(denominator);
 
   // Numbers could be too large for T
-  reduce();
+  if (!details::fitsInto<T>(numerator) || !details::fitsInto<T>(denominator)) reduce();
 }
 
 template <class T, class CHECK_T>
@@ -489,8 +1571,12 @@ template <class D, class CHECK_D>
 inline constexpr fraction<T, CHECK_T>::fraction(const D& value, const D& precison) : numerator{}, denominator{} {
   constexpr D D_ZERO{0};
   constexpr D D_ONE{1};
+  constexpr int DIGITS{std::numeric_limits<D>::digits};
+  constexpr int T_DIGITS{std::numeric_limits<T>::digits};
+  constexpr std::uint64_t MAX_POSITIVE{static_cast<std::uint64_t>(std::numeric_limits<T>::max())};
+  constexpr D D_MAX_POSITIVE{static_cast<D>(MAX_POSITIVE)};
 
-  T digitT{};
+  if (details::isNaN(value)) throw std::invalid_argument("The value must not be NaN!");
 
   const bool negative = value < D_ZERO;
 
@@ -499,41 +1585,124 @@ inline constexpr fraction<T, CHECK_T>::fraction(const D& value, const D& preciso
       throw std::invalid_argument("The value needs to be positive, since the base interger type is unsigned!");
 
   const D posValue{negative ? -value : value};
+
+  if (posValue == D_ZERO) {
+    numerator = ZERO;
+    denominator = ONE;
+
+    return;
+  }
+
+  if (posValue > std::numeric_limits<D>::max()) throw std::overflow_error("The result does not fit into the fraction!");
+
+  // value = mantissa * 2^exponent, with an odd mantissa. So mantissa / 2^-exponent is reduced already
+  std::uint64_t mantissa{};
+  int exponent{};
+
+  details::decompose(posValue, mantissa, exponent);
+
+  const int mantissaWidth{details::bitWidth(mantissa)};
+  const auto assignMagnitude = [&](std::uint64_t magnitude) {
+    const unsigned_type narrowMagnitude{static_cast<unsigned_type>(magnitude)};
+
+    numerator = static_cast<T>(negative ? static_cast<unsigned_type>(unsigned_type{0} - narrowMagnitude)
+                                        : narrowMagnitude);
+  };
+
+  if (exponent >= 0) {
+    // Integer. The minimum of a signed T has one more magnitude than the maximum
+    const std::uint64_t limit{(is_signed && negative) ? MAX_POSITIVE + 1 : MAX_POSITIVE};
+
+    if ((mantissaWidth + exponent > 64) || ((mantissa << exponent) > limit))
+      throw std::overflow_error("The result does not fit into the fraction!");
+
+    assignMagnitude(mantissa << exponent);
+    denominator = ONE;
+
+    return;
+  }
+
+  const int shift{-exponent};
+  const bool exactFits{(shift < T_DIGITS) && (mantissa <= MAX_POSITIVE)};
+
+  if ((shift < 64) && ((mantissa >> shift) > MAX_POSITIVE))
+    throw std::overflow_error("The result does not fit into the fraction!");
+
+  // All fractions with a denominator of at most 2^shift are at least 2^(-2 * shift) apart. If that's more than the
+  // rounding error of the value, no fraction with a smaller denominator rounds to it, so it's what the continued
+  // fraction would find as well
+  if ((precison == D_ZERO) && exactFits && (shift + mantissaWidth <= DIGITS)) {
+    assignMagnitude(mantissa);
+    denominator = static_cast<T>(T{1} << shift);
+
+    return;
+  }
+
   D rest{posValue};
 
   T n1{ONE};
   T n2{ZERO};
   T d1{ZERO};
   T d2{ONE};
-  T tmp{};
 
   while (true) {
-    digitT = static_cast<T>(rest);
+    const T digitT{static_cast<T>(rest)};
+    const wide_type nextN1{static_cast<wide_type>(details::multiply(static_cast<unsigned_type>(digitT),
+                                                                    static_cast<unsigned_type>(n1)) +
+                                                  wide_type{static_cast<unsigned_type>(n2)})};
+    const wide_type nextD1{static_cast<wide_type>(details::multiply(static_cast<unsigned_type>(digitT),
+                                                                    static_cast<unsigned_type>(d1)) +
+                                                  wide_type{static_cast<unsigned_type>(d2)})};
+
+    // The next convergent doesn't fit anymore. The exact value is closer if it fits
+    if ((nextN1 > wide_type{MAX_POSITIVE}) || (nextD1 > wide_type{MAX_POSITIVE})) {
+      if (exactFits) {
+        n1 = static_cast<T>(mantissa);
+        d1 = static_cast<T>(T{1} << shift);
+      }
+
+      break;
+    }
 
-    tmp = n1;
-    n1 = (digitT * n1) + n2;
-    n2 = tmp;
+    n2 = n1;
+    n1 = static_cast<T>(nextN1);
+    d2 = d1;
+    d1 = static_cast<T>(nextD1);
 
-    tmp = d1;
-    d1 = (digitT * d1) + d2;
-    d2 = tmp;
+    const D fractionalPart{rest - static_cast<D>(digitT)};
 
-    if (fraction<T, CHECK_T>::abs((static_cast<D>(n1) / static_cast<D>(d1)) - posValue) <= precison) break;
+    if ((fraction<T, CHECK_T>::abs((static_cast<D>(n1) / static_cast<D>(d1)) - posValue) <= precison) ||
+        (fractionalPart == D_ZERO))
+      break;
 
-    rest = D_ONE / (rest - static_cast<D>(digitT));
+    rest = D_ONE / fractionalPart;
+
+    // The next digit alone would overflow
+    if (!(rest < D_MAX_POSITIVE)) {
+      if (exactFits) {
+        n1 = static_cast<T>(mantissa);
+        d1 = static_cast<T>(T{1} << shift);
+      }
+
+      break;
+    }
   }
 
-  if constexpr (is_signed)
-    numerator = negative ? -n1 : n1;
-  else
-    numerator = n1;
+  assignMagnitude(static_cast<std::uint64_t>(n1));
   denominator = d1;
 }
 
 template <class T, class CHECK_T>
 template <class T1, class CHECK_T1>
 inline constexpr fraction<T, CHECK_T>::fraction(const fraction<T1, CHECK_T1>& copy)
-    : fraction(static_cast<T>(copy.numerator), static_cast<T>(copy.denominator)) {}
+    : numerator{static_cast<T>(copy.numerator)}, denominator{static_cast<T>(copy.denominator)} {
+  // The source is reduced already, so only values that don't fit into T need another reduction
+  if (!details::fitsInto<T>(copy.numerator) || !details::fitsInto<T>(copy.denominator)) reduce();
+}
+
+template <class T, class CHECK_T>
+inline constexpr fraction<T, CHECK_T>::fraction(const T& numerator, const T& denominator, reduced_tag) noexcept
+    : numerator{numerator}, denominator{denominator} {}
 
 template <class T, class CHECK_T>
 inline constexpr const T& fraction<T, CHECK_T>::getNumerator() const noexcept {
@@ -545,6 +1714,84 @@ inline constexpr const T& fraction<T, CHECK_T>::getDenominator() const noexcept
   return denominator;
 }
 
+template <class T, class CHECK_T>
+inline constexpr fraction<T, CHECK_T> fraction<T, CHECK_T>::limitDenominator(const T& maxDenominator) const {
+  if (maxDenominator < ONE) throw std::invalid_argument("The maximum denominator must be at least 1!");
+
+  unsigned_type resultNumerator{};
+  unsigned_type resultDenominator{};
+
+  details::limitDenominator(details::magnitude(numerator), static_cast<unsigned_type>(denominator),
+                            static_cast<unsigned_type>(maxDenominator), isNegative(numerator), resultNumerator,
+                            resultDenominator);
+
+  const T signedNumerator{static_cast<T>(isNegative(numerator)
+                                             ? static_cast<unsigned_type>(unsigned_type{0} - resultNumerator)
+                                             : resultNumerator)};
+
+  return fraction<T, CHECK_T>{signedNumerator, static_cast<T>(resultDenominator), reduced_tag{}};
+}
+
+template <class T, class CHECK_T>
+template <class D, class CHECK_D>
+inline constexpr fraction<T, CHECK_T> fraction<T, CHECK_T>::limitDenominator(const D& value,
+                                                                            const T& maxDenominator) {
+  // Wide enough for any mantissa, and for denominators up to 2^127
+  typedef details::wide_t<std::uint64_t> U;
+
+  constexpr D D_ZERO{0};
+  constexpr U MAX_POSITIVE{static_cast<std::uint64_t>(std::numeric_limits<T>::max())};
+
+  if (maxDenominator < ONE) throw std::invalid_argument("The maximum denominator must be at least 1!");
+
+  if (details::isNaN(value)) throw std::invalid_argument("The value must not be NaN!");
+
+  const bool negative = value < D_ZERO;
+
+  if constexpr (is_unsigned)
+    if (negative)
+      throw std::invalid_argument("The value needs to be positive, since the base interger type is unsigned!");
+
+  const D posValue{negative ? -value : value};
+
+  if (posValue == D_ZERO) return fraction<T, CHECK_T>{};
+
+  if (posValue > std::numeric_limits<D>::max()) throw std::overflow_error("The result does not fit into the fraction!");
+
+  std::uint64_t mantissa{};
+  int exponent{};
+
+  details::decompose(posValue, mantissa, exponent);
+
+  // Integers are their own best approximation
+  if (exponent >= 0) return fraction<T, CHECK_T>{value};
+
+  const int shift{-exponent};
+  const U maxDenominatorU{static_cast<std::uint64_t>(maxDenominator)};
+
+  U resultNumerator{};
+  U resultDenominator{1};
+
+  if (shift < 128) {
+    details::limitDenominator(U{mantissa}, static_cast<U>(U{1} << shift), maxDenominatorU, negative, resultNumerator,
+                              resultDenominator);
+  } else if ((shift == 128) && (static_cast<U>(U{mantissa} * maxDenominatorU) > static_cast<U>(U{1} << 127))) {
+    // Below 2^-64 the only candidates are 0 and 1 / maxDenominator. A tie goes to 0 for either sign
+    resultNumerator = U{1};
+    resultDenominator = maxDenominatorU;
+  }
+
+  const U limit{(is_signed && negative) ? static_cast<U>(MAX_POSITIVE + U{1}) : MAX_POSITIVE};
+
+  if (resultNumerator > limit) throw std::overflow_error("The result does not fit into the fraction!");
+
+  const unsigned_type narrowNumerator{static_cast<unsigned_type>(static_cast<std::uint64_t>(resultNumerator))};
+
+  return fraction<T, CHECK_T>{
+      static_cast<T>(negative ? static_cast<unsigned_type>(unsigned_type{0} - narrowNumerator) : narrowNumerator),
+      static_cast<T>(static_cast<std::uint64_t>(resultDenominator)), reduced_tag{}};
+}
+
 template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
 inline constexpr bool operator==(const fraction<T1, CHECK_T1>& lhs, const fraction<T2, CHECK_T2>& rhs) {
   return fraction<COMMON, CHECK_COMMON>{lhs} == fraction<COMMON, CHECK_COMMON>{rhs};
@@ -557,6 +1804,9 @@ inline constexpr bool operator==(const fraction<T1, CHECK_T1>& lhs, const fracti
 
 template <class T1, class CHECK_T1, class D, class CHECK_D>
 inline constexpr bool operator==(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
+  if (details::isIntegerOperand<T1>(rhs))
+    return (lhs.denominator == fraction<T1, CHECK_T1>::ONE) && (lhs.numerator == static_cast<T1>(rhs));
+
   return lhs == fraction<T1, CHECK_T1>{rhs};
 }
 
@@ -587,140 +1837,140 @@ inline constexpr bool operator!=(const D& lhs, const fraction<T1, CHECK_T1>& rhs
 
 template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
 inline constexpr bool operator<(const fraction<T1, CHECK_T1>& lhs, const fraction<T2, CHECK_T2>& rhs) {
-  return fraction<COMMON, CHECK_COMMON>{lhs} < fraction<COMMON, CHECK_COMMON>{rhs};
+  return fraction<COMMON, CHECK_COMMON>::compare(fraction<COMMON, CHECK_COMMON>{lhs},
+                                                 fraction<COMMON, CHECK_COMMON>{rhs}) < 0;
 }
 
 template <class T1, class CHECK_T1>
 inline constexpr bool operator<(const fraction<T1, CHECK_T1>& lhs, const fraction<T1, CHECK_T1>& rhs) noexcept {
-  constexpr T1 T1_ZERO{0};
-
-  T1 numerator_lhs{lhs.numerator};
-  T1 denominator_lhs{lhs.denominator};
-  T1 numerator_rhs{rhs.numerator};
-  T1 denominator_rhs{rhs.denominator};
-
-  T1 divison_lhs{};
-  T1 divison_rhs{};
-
-  bool flag{true};
-  bool negative{false};
-
-  if constexpr (fraction<T1, CHECK_T1>::is_signed) {
-    const bool lhsNegative{numerator_lhs < T1_ZERO};
-    const bool rhsNegative{numerator_rhs < T1_ZERO};
-
-    if (lhsNegative && !rhsNegative) return true;
-    if (!lhsNegative && rhsNegative) return false;
-
-    negative = lhsNegative && rhsNegative;
-  }
-
-  while (true) {
-    divison_lhs = numerator_lhs / denominator_lhs;
-    divison_rhs = numerator_rhs / denominator_rhs;
-
-    if (divison_lhs < divison_rhs) return flag;
-    if (divison_lhs > divison_rhs) return !flag;
-
-    // Use divison_lhs and divison_rhs as temporary variables
-    divison_lhs = numerator_lhs;
-    numerator_lhs = denominator_lhs;
-    denominator_lhs = divison_lhs % denominator_lhs;
-
-    divison_rhs = numerator_rhs;
-    numerator_rhs = denominator_rhs;
-    denominator_rhs = divison_rhs % denominator_rhs;
-
-    if (negative ^ flag) {
-      if (denominator_rhs == T1_ZERO) return false;
-      if (denominator_lhs == T1_ZERO) return true;
-    } else {
-      if (denominator_lhs == T1_ZERO) return false;
-      if (denominator_rhs == T1_ZERO) return true;
-    }
-
-    flag = !flag;
-  }
+  return fraction<T1, CHECK_T1>::compare(lhs, rhs) < 0;
 }
 
 template <class T1, class CHECK_T1, class D, class CHECK_D>
 inline constexpr bool operator<(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
-  return lhs < fraction<T1, CHECK_T1>{rhs};
+  if (details::isIntegerOperand<T1>(rhs)) return fraction<T1, CHECK_T1>::compareInteger(lhs, static_cast<T1>(rhs)) < 0;
+
+  return fraction<T1, CHECK_T1>::compare(lhs, fraction<T1, CHECK_T1>{rhs}) < 0;
 }
 
 template <class D, class T1, class CHECK_T1, class CHECK_D>
 inline constexpr bool operator<(const D& lhs, const fraction<T1, CHECK_T1>& rhs) {
-  return fraction<T1, CHECK_T1>{lhs} < rhs;
+  if (details::isIntegerOperand<T1>(lhs)) return fraction<T1, CHECK_T1>::compareInteger(rhs, static_cast<T1>(lhs)) > 0;
+
+  return fraction<T1, CHECK_T1>::compare(fraction<T1, CHECK_T1>{lhs}, rhs) < 0;
 }
 
 template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
 inline constexpr bool operator>(const fraction<T1, CHECK_T1>& lhs, const fraction<T2, CHECK_T2>& rhs) {
-  return rhs < lhs;
+  return fraction<COMMON, CHECK_COMMON>::compare(fraction<COMMON, CHECK_COMMON>{lhs},
+                                                 fraction<COMMON, CHECK_COMMON>{rhs}) > 0;
 }
 
 template <class T1, class CHECK_T1>
 inline constexpr bool operator>(const fraction<T1, CHECK_T1>& lhs, const fraction<T1, CHECK_T1>& rhs) noexcept {
-  return rhs < lhs;
+  return fraction<T1, CHECK_T1>::compare(lhs, rhs) > 0;
 }
 
 template <class T1, class CHECK_T1, class D, class CHECK_D>
 inline constexpr bool operator>(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
-  return rhs < lhs;
+  if (details::isIntegerOperand<T1>(rhs)) return fraction<T1, CHECK_T1>::compareInteger(lhs, static_cast<T1>(rhs)) > 0;
+
+  return fraction<T1, CHECK_T1>::compare(lhs, fraction<T1, CHECK_T1>{rhs}) > 0;
 }
 
 template <class D, class T1, class CHECK_T1, class CHECK_D>
 inline constexpr bool operator>(const D& lhs, const fraction<T1, CHECK_T1>& rhs) {
-  return rhs < lhs;
+  if (details::isIntegerOperand<T1>(lhs)) return fraction<T1, CHECK_T1>::compareInteger(rhs, static_cast<T1>(lhs)) < 0;
+
+  return fraction<T1, CHECK_T1>::compare(fraction<T1, CHECK_T1>{lhs}, rhs) > 0;
 }
 
 template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
 inline constexpr bool operator<=(const fraction<T1, CHECK_T1>& lhs, const fraction<T2, CHECK_T2>& rhs) {
-  return !(lhs > rhs);
+  return fraction<COMMON, CHECK_COMMON>::compare(fraction<COMMON, CHECK_COMMON>{lhs},
+                                                 fraction<COMMON, CHECK_COMMON>{rhs}) <= 0;
 }
 
 template <class T1, class CHECK_T1>
 inline constexpr bool operator<=(const fraction<T1, CHECK_T1>& lhs, const fraction<T1, CHECK_T1>& rhs) noexcept {
-  return !(lhs > rhs);
+  return fraction<T1, CHECK_T1>::compare(lhs, rhs) <= 0;
 }
 
 template <class T1, class CHECK_T1, class D, class CHECK_D>
 inline constexpr bool operator<=(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
-  return !(lhs > rhs);
+  if (details::isIntegerOperand<T1>(rhs)) return fraction<T1, CHECK_T1>::compareInteger(lhs, static_cast<T1>(rhs)) <= 0;
+
+  return fraction<T1, CHECK_T1>::compare(lhs, fraction<T1, CHECK_T1>{rhs}) <= 0;
 }
 
 template <class D, class T1, class CHECK_T1, class CHECK_D>
 inline constexpr bool operator<=(const D& lhs, const fraction<T1, CHECK_T1>& rhs) {
-  return !(lhs > rhs);
+  if (details::isIntegerOperand<T1>(lhs)) return fraction<T1, CHECK_T1>::compareInteger(rhs, static_cast<T1>(lhs)) >= 0;
+
+  return fraction<T1, CHECK_T1>::compare(fraction<T1, CHECK_T1>{lhs}, rhs) <= 0;
 }
 
 template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
 inline constexpr bool operator>=(const fraction<T1, CHECK_T1>& lhs, const fraction<T2, CHECK_T2>& rhs) {
-  return !(lhs > rhs);
+  return fraction<COMMON, CHECK_COMMON>::compare(fraction<COMMON, CHECK_COMMON>{lhs},
+                                                 fraction<COMMON, CHECK_COMMON>{rhs}) >= 0;
 }
 
 template <class T1, class CHECK_T1>
 inline constexpr bool operator>=(const fraction<T1, CHECK_T1>& lhs, const fraction<T1, CHECK_T1>& rhs) noexcept {
-  return !(lhs < rhs);
+  return fraction<T1, CHECK_T1>::compare(lhs, rhs) >= 0;
 }
 
 template <class T1, class CHECK_T1, class D, class CHECK_D>
 inline constexpr bool operator>=(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
-  return !(lhs < rhs);
+  if (details::isIntegerOperand<T1>(rhs)) return fraction<T1, CHECK_T1>::compareInteger(lhs, static_cast<T1>(rhs)) >= 0;
+
+  return fraction<T1, CHECK_T1>::compare(lhs, fraction<T1, CHECK_T1>{rhs}) >= 0;
 }
 
 template <class D, class T1, class CHECK_T1, class CHECK_D>
 inline constexpr bool operator>=(const D& lhs, const fraction<T1, CHECK_T1>& rhs) {
-  return !(lhs < rhs);
+  if (details::isIntegerOperand<T1>(lhs)) return fraction<T1, CHECK_T1>::compareInteger(rhs, static_cast<T1>(lhs)) <= 0;
+
+  return fraction<T1, CHECK_T1>::compare(fraction<T1, CHECK_T1>{lhs}, rhs) >= 0;
+}
+
+#ifdef FRACTION_HAS_THREE_WAY_COMPARISON
+template <class T1, class CHECK_T1, class T2, class CHECK_T2, class COMMON, class CHECK_COMMON>
+inline constexpr std::strong_ordering operator<=>(const fraction<T1, CHECK_T1>& lhs,
+                                                  const fraction<T2, CHECK_T2>& rhs) {
+  return fraction<COMMON, CHECK_COMMON>{lhs} <=> fraction<COMMON, CHECK_COMMON>{rhs};
+}
+
+template <class T1, class CHECK_T1>
+inline constexpr std::strong_ordering operator<=>(const fraction<T1, CHECK_T1>& lhs,
+                                                  const fraction<T1, CHECK_T1>& rhs) noexcept {
+  return fraction<T1, CHECK_T1>::compare(lhs, rhs) <=> 0;
+}
+
+template <class T1, class CHECK_T1, class D, class CHECK_D>
+inline constexpr std::strong_ordering operator<=>(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
+  if (details::isIntegerOperand<T1>(rhs))
+    return fraction<T1, CHECK_T1>::compareInteger(lhs, static_cast<T1>(rhs)) <=> 0;
+
+  return lhs <=> fraction<T1, CHECK_T1>{rhs};
 }
+#endif
 
 template <class T, class CHECK_T>
 inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator+=(const fraction<T, CHECK_T>& rhs) {
-  const T lcm{std::lcm(denominator, rhs.denominator)};
+  add(rhs, false);
 
-  numerator = (numerator * (lcm / denominator)) + (rhs.numerator * (lcm / rhs.denominator));
-  denominator = lcm;
+  return *this;
+}
 
-  reduce();
+template <class T, class CHECK_T>
+template <class D, class CHECK_D>
+inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator+=(const D& rhs) {
+  if (details::fitsInto<T>(rhs))
+    addInteger(static_cast<T>(rhs), false, false);
+  else
+    add(fraction<T, CHECK_T>{rhs}, false);
 
   return *this;
 }
@@ -745,22 +1995,42 @@ inline constexpr fraction<T1, CHECK_T1> operator+(const fraction<T1, CHECK_T1>&
 
 template <class T1, class CHECK_T1, class D, class CHECK_D>
 inline constexpr fraction<T1, CHECK_T1> operator+(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
+  if (details::isIntegerOperand<T1>(rhs)) {
+    fraction<T1, CHECK_T1> out{lhs};
+    out += rhs;
+
+    return out;
+  }
+
   return lhs + fraction<T1, CHECK_T1>{rhs};
 }
 
 template <class D, class T1, class CHECK_T1, class CHECK_D>
 inline constexpr fraction<T1, CHECK_T1> operator+(const D& lhs, const fraction<T1, CHECK_T1>& rhs) {
-  return rhs + lhs;
+  if (details::isIntegerOperand<T1>(lhs)) {
+    fraction<T1, CHECK_T1> out{rhs};
+    out.addInteger(static_cast<T1>(lhs), false, false);
+
+    return out;
+  }
+
+  return fraction<T1, CHECK_T1>{lhs} + rhs;
 }
 
 template <class T, class CHECK_T>
 inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator-=(const fraction<T, CHECK_T>& rhs) {
-  const T lcm{std::lcm(denominator, rhs.denominator)};
+  add(rhs, true);
 
-  numerator = (numerator * (lcm / denominator)) - (rhs.numerator * (lcm / rhs.denominator));
-  denominator = lcm;
+  return *this;
+}
 
-  reduce();
+template <class T, class CHECK_T>
+template <class D, class CHECK_D>
+inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator-=(const D& rhs) {
+  if (details::fitsInto<T>(rhs))
+    addInteger(static_cast<T>(rhs), true, false);
+  else
+    add(fraction<T, CHECK_T>{rhs}, true);
 
   return *this;
 }
@@ -785,20 +2055,79 @@ inline constexpr fraction<T1, CHECK_T1> operator-(const fraction<T1, CHECK_T1>&
 
 template <class T1, class CHECK_T1, class D, class CHECK_D>
 inline constexpr fraction<T1, CHECK_T1> operator-(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
+  if (details::isIntegerOperand<T1>(rhs)) {
+    fraction<T1, CHECK_T1> out{lhs};
+    out -= rhs;
+
+    return out;
+  }
+
   return lhs - fraction<T1, CHECK_T1>{rhs};
 }
 
 template <class D, class T1, class CHECK_T1, class CHECK_D>
 inline constexpr fraction<T1, CHECK_T1> operator-(const D& lhs, const fraction<T1, CHECK_T1>& rhs) {
+  if (details::isIntegerOperand<T1>(lhs)) {
+    fraction<T1, CHECK_T1> out{rhs};
+    out.addInteger(static_cast<T1>(lhs), false, true);
+
+    return out;
+  }
+
   return fraction<T1, CHECK_T1>{lhs} - rhs;
 }
 
 template <class T, class CHECK_T>
 inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator*=(const fraction<T, CHECK_T>& rhs) {
-  numerator *= rhs.numerator;
-  denominator *= rhs.denominator;
+  // Fast paths: Zero and integer valued operands
+  if ((numerator == ZERO) || (rhs.numerator == ZERO)) {
+    numerator = ZERO;
+    denominator = ONE;
 
-  reduce();
+    return *this;
+  }
+
+  if (rhs.denominator == ONE) {
+    multiplyInteger(rhs.numerator);
+
+    return *this;
+  }
+
+  if (denominator == ONE) {
+    const T value{numerator};
+
+    *this = rhs;
+    multiplyInteger(value);
+
+    return *this;
+  }
+
+  const unsigned_type lhsNumerator{details::magnitude(numerator)};
+  const unsigned_type lhsDenominator{details::magnitude(denominator)};
+  const unsigned_type rhsNumerator{details::magnitude(rhs.numerator)};
+  const unsigned_type rhsDenominator{details::magnitude(rhs.denominator)};
+
+  // Henrici: Cancel the common factors crosswise before multiplying. Both operands are reduced, so the products are
+  // reduced as well
+  const unsigned_type gcd1{details::gcd(lhsNumerator, rhsDenominator)};
+  const unsigned_type gcd2{details::gcd(rhsNumerator, lhsDenominator)};
+
+  assignReduced(isNegative(numerator) != isNegative(rhs.numerator),
+                details::multiply(static_cast<unsigned_type>(lhsNumerator / gcd1),
+                                  static_cast<unsigned_type>(rhsNumerator / gcd2)),
+                details::multiply(static_cast<unsigned_type>(lhsDenominator / gcd2),
+                                  static_cast<unsigned_type>(rhsDenominator / gcd1)));
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+template <class D, class CHECK_D>
+inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator*=(const D& rhs) {
+  if (details::fitsInto<T>(rhs))
+    multiplyInteger(static_cast<T>(rhs));
+  else
+    operator*=(fraction<T, CHECK_T>{rhs});
 
   return *this;
 }
@@ -812,31 +2141,86 @@ inline constexpr fraction<COMMON, CHECK_COMMON> operator*(const fraction<T1, CHE
   return out;
 }
 
-template <class T1, class CHECK_T1>
-inline constexpr fraction<T1, CHECK_T1> operator*(const fraction<T1, CHECK_T1>& lhs,
-                                                  const fraction<T1, CHECK_T1>& rhs) {
-  fraction<T1, CHECK_T1> out{lhs};
-  out *= rhs;
+template <class T1, class CHECK_T1>
+inline constexpr fraction<T1, CHECK_T1> operator*(const fraction<T1, CHECK_T1>& lhs,
+                                                  const fraction<T1, CHECK_T1>& rhs) {
+  fraction<T1, CHECK_T1> out{lhs};
+  out *= rhs;
+
+  return out;
+}
+
+template <class T1, class CHECK_T1, class D, class CHECK_D>
+inline constexpr fraction<T1, CHECK_T1> operator*(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
+  if (details::isIntegerOperand<T1>(rhs)) {
+    fraction<T1, CHECK_T1> out{lhs};
+    out *= rhs;
+
+    return out;
+  }
+
+  return lhs * fraction<T1, CHECK_T1>{rhs};
+}
+
+template <class D, class T1, class CHECK_T1, class CHECK_D>
+inline constexpr fraction<T1, CHECK_T1> operator*(const D& lhs, const fraction<T1, CHECK_T1>& rhs) {
+  if (details::isIntegerOperand<T1>(lhs)) {
+    fraction<T1, CHECK_T1> out{rhs};
+    out.multiplyInteger(static_cast<T1>(lhs));
+
+    return out;
+  }
+
+  return fraction<T1, CHECK_T1>{lhs} * rhs;
+}
+
+template <class T, class CHECK_T>
+inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator/=(const fraction<T, CHECK_T>& rhs) {
+  if (rhs.numerator == ZERO) throw std::invalid_argument("The denominator must not be 0!");
+
+  // Fast paths: Zero and integer valued operands
+  if (numerator == ZERO) return *this;
+
+  if (rhs.denominator == ONE) {
+    divideInteger(rhs.numerator, false);
+
+    return *this;
+  }
+
+  if (denominator == ONE) {
+    const T value{numerator};
+
+    *this = rhs;
+    divideInteger(value, true);
+
+    return *this;
+  }
+
+  const unsigned_type lhsNumerator{details::magnitude(numerator)};
+  const unsigned_type lhsDenominator{details::magnitude(denominator)};
+  const unsigned_type rhsNumerator{details::magnitude(rhs.numerator)};
+  const unsigned_type rhsDenominator{details::magnitude(rhs.denominator)};
 
-  return out;
-}
+  // Henrici: Same as multiplying with the reciprocal
+  const unsigned_type gcd1{details::gcd(lhsNumerator, rhsNumerator)};
+  const unsigned_type gcd2{details::gcd(rhsDenominator, lhsDenominator)};
 
-template <class T1, class CHECK_T1, class D, class CHECK_D>
-inline constexpr fraction<T1, CHECK_T1> operator*(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
-  return lhs * fraction<T1, CHECK_T1>{rhs};
-}
+  assignReduced(isNegative(numerator) != isNegative(rhs.numerator),
+                details::multiply(static_cast<unsigned_type>(lhsNumerator / gcd1),
+                                  static_cast<unsigned_type>(rhsDenominator / gcd2)),
+                details::multiply(static_cast<unsigned_type>(lhsDenominator / gcd2),
+                                  static_cast<unsigned_type>(rhsNumerator / gcd1)));
 
-template <class D, class T1, class CHECK_T1, class CHECK_D>
-inline constexpr fraction<T1, CHECK_T1> operator*(const D& lhs, const fraction<T1, CHECK_T1>& rhs) {
-  return rhs * lhs;
+  return *this;
 }
 
 template <class T, class CHECK_T>
-inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator/=(const fraction<T, CHECK_T>& rhs) {
-  numerator *= rhs.denominator;
-  denominator *= rhs.numerator;
-
-  reduce();
+template <class D, class CHECK_D>
+inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator/=(const D& rhs) {
+  if (details::fitsInto<T>(rhs))
+    divideInteger(static_cast<T>(rhs), false);
+  else
+    operator/=(fraction<T, CHECK_T>{rhs});
 
   return *this;
 }
@@ -861,20 +2245,35 @@ inline constexpr fraction<T1, CHECK_T1> operator/(const fraction<T1, CHECK_T1>&
 
 template <class T1, class CHECK_T1, class D, class CHECK_D>
 inline constexpr fraction<T1, CHECK_T1> operator/(const fraction<T1, CHECK_T1>& lhs, const D& rhs) {
+  if (details::isIntegerOperand<T1>(rhs)) {
+    fraction<T1, CHECK_T1> out{lhs};
+    out /= rhs;
+
+    return out;
+  }
+
   return lhs / fraction<T1, CHECK_T1>{rhs};
 }
 
 template <class D, class T1, class CHECK_T1, class CHECK_D>
 inline constexpr fraction<T1, CHECK_T1> operator/(const D& lhs, const fraction<T1, CHECK_T1>& rhs) {
+  if (details::isIntegerOperand<T1>(lhs)) {
+    fraction<T1, CHECK_T1> out{rhs};
+    out.divideInteger(static_cast<T1>(lhs), true);
+
+    return out;
+  }
+
   return fraction<T1, CHECK_T1>{lhs} / rhs;
 }
 
 template <class T, class CHECK_T>
 inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator++() {
-  numerator += denominator;
+  if (numerator > std::numeric_limits<T>::max() - denominator)
+    throw std::overflow_error("The result does not fit into the fraction!");
 
-  // Just in case of interger overflow
-  reduce();
+  // gcd(n + d, d) = gcd(n, d) = 1, so the result stays reduced
+  numerator += denominator;
 
   return *this;
 }
@@ -890,10 +2289,18 @@ inline constexpr fraction<T, CHECK_T> fraction<T, CHECK_T>::operator++(int) {
 
 template <class T, class CHECK_T>
 inline constexpr fraction<T, CHECK_T>& fraction<T, CHECK_T>::operator--() {
-  numerator -= denominator;
+  if constexpr (is_signed) {
+    if (numerator < std::numeric_limits<T>::min() + denominator)
+      throw std::overflow_error("The result does not fit into the fraction!");
+  } else if (numerator < denominator) {
+    // Negative results wrap around just like in operator-=
+    add(fraction<T, CHECK_T>{ONE, ONE, reduced_tag{}}, true);
 
-  // Just in case of interger overflow
-  reduce();
+    return *this;
+  }
+
+  // gcd(n - d, d) = gcd(n, d) = 1, so the result stays reduced
+  numerator -= denominator;
 
   return *this;
 }
@@ -914,13 +2321,60 @@ inline constexpr fraction<T1, CHECK_T1> operator+(const fraction<T1, CHECK_T1>&
 
 template <class T1, class CHECK_T1>
 inline constexpr fraction<T1, CHECK_T1> operator-(const fraction<T1, CHECK_T1>& rhs) {
-  return fraction<T1, CHECK_T1>{-rhs.numerator, rhs.denominator};
+  typedef fraction<T1, CHECK_T1> fraction_type;
+
+  if constexpr (fraction_type::is_signed) {
+    if (rhs.numerator == std::numeric_limits<T1>::min())
+      throw std::overflow_error("The result does not fit into the fraction!");
+
+    // Negating doesn't change the gcd
+    return fraction_type{static_cast<T1>(-rhs.numerator), rhs.denominator, typename fraction_type::reduced_tag{}};
+  } else {
+    // The wrapped around numerator can share factors with the denominator
+    return fraction_type{static_cast<T1>(-rhs.numerator), rhs.denominator};
+  }
 }
 
 template <class T, class CHECK_T>
 template <class D, class CHECK_D>
 inline constexpr fraction<T, CHECK_T>::operator D() const noexcept {
-  return static_cast<D>(numerator) / static_cast<D>(denominator);
+  if constexpr (std::is_floating_point<D>::value)
+    return toFloatingPoint<D>();
+  else
+    return static_cast<D>(numerator) / static_cast<D>(denominator);
+}
+
+template <class T, class CHECK_T>
+template <class D, class CHECK_D>
+inline constexpr D fraction<T, CHECK_T>::toFloatingPoint(std::float_round_style roundStyle) const noexcept {
+  constexpr int D_DIGITS{std::numeric_limits<D>::digits};
+  constexpr bool ALWAYS_EXACT{std::numeric_limits<unsigned_type>::digits <= D_DIGITS};
+  constexpr unsigned_type EXACT_LIMIT{ALWAYS_EXACT ? std::numeric_limits<unsigned_type>::max()
+                                                   : static_cast<unsigned_type>(unsigned_type{1}
+                                                                                << (ALWAYS_EXACT ? 0 : D_DIGITS))};
+
+  const unsigned_type magnitudeNumerator{details::magnitude(numerator)};
+  const unsigned_type magnitudeDenominator{details::magnitude(denominator)};
+  const bool toNearest{(roundStyle == std::round_to_nearest) || (roundStyle == std::round_indeterminate)};
+
+  // Both operands are exact, so the division is the only rounding
+  if (toNearest && (magnitudeNumerator <= EXACT_LIMIT) && (magnitudeDenominator <= EXACT_LIMIT))
+    return static_cast<D>(numerator) / static_cast<D>(denominator);
+
+  // Where long double holds all values of T exactly (like the x87 format), dividing in it and rounding again is only
+  // wrong when the first quotient lands exactly between two values of D. 2 * quotient - result is a value of D then
+  if constexpr ((std::numeric_limits<long double>::digits >= std::numeric_limits<unsigned_type>::digits) &&
+                (std::numeric_limits<long double>::digits > D_DIGITS)) {
+    if (toNearest) {
+      const long double quotient{static_cast<long double>(numerator) / static_cast<long double>(denominator)};
+      const D result{static_cast<D>(quotient)};
+      const long double mirrored{(2.0L * quotient) - static_cast<long double>(result)};
+
+      if ((mirrored == quotient) || (static_cast<long double>(static_cast<D>(mirrored)) != mirrored)) return result;
+    }
+  }
+
+  return details::divideRounded<D>(magnitudeNumerator, magnitudeDenominator, isNegative(numerator), roundStyle);
 }
 
 template <class charT, class traits, class T1, class CHECK_T1>
@@ -931,6 +2385,277 @@ inline std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, t
   return ostream;
 }
 
+template <class charT, class traits, class T1, class CHECK_T1>
+inline std::basic_istream<charT, traits>& operator>>(std::basic_istream<charT, traits>& istream,
+                                                     fraction<T1, CHECK_T1>& fraction) {
+  // Enough for any literal that fits, unless it's padded with lots of zeros
+  constexpr std::size_t BUFFER_SIZE{128};
+
+  const typename std::basic_istream<charT, traits>::sentry sentry{istream};
+
+  if (!sentry) return istream;
+
+  char buffer[BUFFER_SIZE]{};
+  std::size_t length{0};
+  std::basic_streambuf<charT, traits>* const streambuf{istream.rdbuf()};
+
+  for (typename traits::int_type next{streambuf->sgetc()};; next = streambuf->snextc()) {
+    if (traits::eq_int_type(next, traits::eof())) {
+      istream.setstate(std::ios_base::eofbit);
+
+      break;
+    }
+
+    const char character{details::narrowLiteralCharacter(traits::to_char_type(next))};
+
+    if (!details::continuesLiteral(buffer, length, character)) break;
+
+    if (length == BUFFER_SIZE) {
+      istream.setstate(std::ios_base::failbit);
+
+      return istream;
+    }
+
+    buffer[length++] = character;
+  }
+
+  const std::from_chars_result result{fraction_from_chars(buffer, buffer + length, fraction)};
+
+  if ((result.ec != std::errc{}) || (result.ptr != (buffer + length))) istream.setstate(std::ios_base::failbit);
+
+  return istream;
+}
+
+template <class T1, class CHECK_T1>
+inline constexpr std::from_chars_result fraction_from_chars(const char* first, const char* last,
+                                                            fraction<T1, CHECK_T1>& value) noexcept {
+  typedef typename fraction<T1, CHECK_T1>::unsigned_type U;
+  // Intermediate digits may exceed T1 as long as the reduced result doesn't
+  typedef details::wide_t<U> W;
+
+  constexpr W MAX_DENOMINATOR{static_cast<U>(std::numeric_limits<T1>::max())};
+
+  const char* current{first};
+  bool negative{false};
+
+  if constexpr (fraction<T1, CHECK_T1>::is_signed) {
+    if ((current != last) && (*current == '-')) {
+      negative = true;
+      ++current;
+    }
+  }
+
+  // The minimum of a signed type has a larger magnitude than its maximum
+  const W maxNumerator{negative ? W{details::magnitude(std::numeric_limits<T1>::min())} : MAX_DENOMINATOR};
+
+  W numerator{0};
+  W denominator{1};
+  std::ptrdiff_t zeros{0};
+  bool overflow{false};
+
+  const char* const integerStart{current};
+  current = details::parseDigits(current, last, numerator, zeros, overflow);
+  const bool hasInteger{current != integerStart};
+
+  if (hasInteger && ((last - current) >= 2) && (current[0] == '/') && details::isDigit(current[1])) {
+    std::ptrdiff_t denominatorZeros{0};
+    denominator = W{0};
+    current = details::parseDigits(current + 1, last, denominator, denominatorZeros, overflow);
+
+    if (overflow) return {current, std::errc::result_out_of_range};
+    if (denominator == W{0}) return {first, std::errc::invalid_argument};
+
+    // Common trailing zeros cancel right away
+    const std::ptrdiff_t commonZeros{(zeros < denominatorZeros) ? zeros : denominatorZeros};
+    constexpr W MAX{static_cast<W>(W{0} - W{1})};
+
+    if (!details::scaleByPowerOfTen(numerator, zeros - commonZeros, MAX) ||
+        !details::scaleByPowerOfTen(denominator, denominatorZeros - commonZeros, MAX))
+      return {current, std::errc::result_out_of_range};
+
+    if (numerator == W{0}) denominator = W{1};
+
+    // Double width divisions are a lot slower, so they are only used when needed
+    if ((numerator <= W{static_cast<U>(~U{0})}) && (denominator <= W{static_cast<U>(~U{0})})) {
+      const U gcd{details::gcd(static_cast<U>(numerator), static_cast<U>(denominator))};
+
+      numerator = W{static_cast<U>(static_cast<U>(numerator) / gcd)};
+      denominator = W{static_cast<U>(static_cast<U>(denominator) / gcd)};
+    } else {
+      const W gcd{details::gcd(numerator, denominator)};
+
+      numerator = static_cast<W>(numerator / gcd);
+      denominator = static_cast<W>(denominator / gcd);
+    }
+  } else {
+    std::ptrdiff_t fractionDigits{0};
+
+    if ((current != last) && (*current == '.')) {
+      const char* const fractionStart{current + 1};
+      const char* const fractionEnd{details::parseDigits(fractionStart, last, numerator, zeros, overflow)};
+
+      if (hasInteger || (fractionEnd != fractionStart)) {
+        fractionDigits = fractionEnd - fractionStart;
+        current = fractionEnd;
+      }
+    }
+
+    if (!hasInteger && (fractionDigits == 0)) return {first, std::errc::invalid_argument};
+
+    std::ptrdiff_t exponent{0};
+
+    if (((last - current) >= 2) && ((*current == 'e') || (*current == 'E'))) {
+      const char* exponentStart{current + 1};
+      const bool negativeExponent{*exponentStart == '-'};
+
+      if ((*exponentStart == '-') || (*exponentStart == '+')) ++exponentStart;
+
+      // Saturates far beyond any exponent that can still fit
+      for (const char* digit = exponentStart; (digit != last) && details::isDigit(*digit); current = ++digit) {
+        if (exponent < 100'000) exponent = (exponent * 10) + (*digit - '0');
+      }
+
+      if (negativeExponent) exponent = -exponent;
+    }
+
+    if (overflow) return {current, std::errc::result_out_of_range};
+
+    const std::ptrdiff_t scale{zeros - fractionDigits + exponent};
+
+    if (numerator == W{0}) {
+      // Nothing to scale
+    } else if (scale >= 0) {
+      if (!details::scaleByPowerOfTen(numerator, scale, maxNumerator)) return {current, std::errc::result_out_of_range};
+    } else {
+      // 10^-scale = 2^-scale * 5^-scale. Cancel what the numerator shares with it and multiply the rest up
+      std::ptrdiff_t twos{-scale};
+      std::ptrdiff_t fives{-scale};
+
+      for (; (twos > 0) && ((numerator & W{1}) == W{0}); --twos) numerator = static_cast<W>(numerator >> 1);
+      for (; (fives > 0) && ((numerator % W{5}) == W{0}); --fives) numerator = static_cast<W>(numerator / W{5});
+
+      const W limitTwos{static_cast<W>(MAX_DENOMINATOR / W{2})};
+      const W limitFives{static_cast<W>(MAX_DENOMINATOR / W{5})};
+
+      for (; twos > 0; --twos) {
+        if (denominator > limitTwos) return {current, std::errc::result_out_of_range};
+
+        denominator = static_cast<W>(denominator << 1);
+      }
+
+      for (; fives > 0; --fives) {
+        if (denominator > limitFives) return {current, std::errc::result_out_of_range};
+
+        denominator = static_cast<W>(denominator * W{5});
+      }
+    }
+  }
+
+  if ((numerator > maxNumerator) || (denominator > MAX_DENOMINATOR)) return {current, std::errc::result_out_of_range};
+
+  const U magnitude{static_cast<U>(numerator)};
+
+  value = fraction<T1, CHECK_T1>{static_cast<T1>(negative ? static_cast<U>(U{0} - magnitude) : magnitude),
+                                 static_cast<T1>(denominator), typename fraction<T1, CHECK_T1>::reduced_tag{}};
+
+  return {current, std::errc{}};
+}
+
+template <class T1, class CHECK_T1>
+inline constexpr std::to_chars_result to_chars(char* first, char* last, const fraction<T1, CHECK_T1>& value,
+                                               fraction_chars_format format, int precision) noexcept {
+  typedef typename std::make_unsigned<T1>::type U;
+
+  const U numerator{details::magnitude(value.getNumerator())};
+  const U denominator{static_cast<U>(value.getDenominator())};
+  const U integerPart{static_cast<U>(numerator / denominator)};
+  U remainder{static_cast<U>(numerator % denominator)};
+
+  char* position{first};
+  const auto put = [&position, last](char character) {
+    if (position == last) return false;
+
+    *position++ = character;
+
+    return true;
+  };
+  const auto putDigits = [&position, last](const U& digits) {
+    position = details::writeDigits(position, last, digits);
+
+    return position != nullptr;
+  };
+  const auto fail = [last]() { return std::to_chars_result{last, std::errc::value_too_large}; };
+
+  if ((value.getNumerator() < T1{0}) && !put('-')) return fail();
+
+  switch (format) {
+    case fraction_chars_format::fraction:
+      if (!putDigits(numerator) || !put('/') || !putDigits(denominator)) return fail();
+
+      break;
+    case fraction_chars_format::compact:
+      if (!putDigits(numerator)) return fail();
+      if ((denominator != U{1}) && (!put('/') || !putDigits(denominator))) return fail();
+
+      break;
+    case fraction_chars_format::mixed:
+      if ((integerPart != U{0}) || (remainder == U{0})) {
+        if (!putDigits(integerPart)) return fail();
+        if ((remainder != U{0}) && !put(' ')) return fail();
+      }
+
+      if ((remainder != U{0}) && (!putDigits(remainder) || !put('/') || !putDigits(denominator))) return fail();
+
+      break;
+    case fraction_chars_format::fixed: {
+      if (precision < 0) precision = 6;
+
+      // At least one integer digit, the point and all decimals. Checked first, so a huge precision fails right away
+      if ((precision > 0) && ((last - position) < (2 + static_cast<std::ptrdiff_t>(precision)))) return fail();
+
+      // The first pass finds how to round and how far a carry runs through trailing nines, the second writes the
+      // digits. Both are the same long division
+      const U initialRemainder{remainder};
+      int lastDigit{static_cast<int>(integerPart % U{10})};
+      int lastNonNine{-1};
+      int digitCount{0};
+
+      for (; (digitCount < precision) && (remainder != U{0}); ++digitCount) {
+        lastDigit = details::nextDecimalDigit(remainder, denominator);
+
+        if (lastDigit != 9) lastNonNine = digitCount;
+      }
+
+      // Compared without doubling the remainder, which could overflow
+      const U half{static_cast<U>(denominator - remainder)};
+      const bool roundUp{(remainder > half) || ((remainder == half) && ((lastDigit % 2) != 0))};
+      const bool carry{roundUp && (lastNonNine < 0)};
+
+      if (!putDigits(static_cast<U>(integerPart + (carry ? U{1} : U{0})))) return fail();
+
+      if (precision > 0) {
+        if ((last - position) < (1 + static_cast<std::ptrdiff_t>(precision))) return fail();
+
+        *position++ = '.';
+        remainder = initialRemainder;
+
+        for (int i = 0; i < precision; ++i) {
+          int digit{(i < digitCount) ? details::nextDecimalDigit(remainder, denominator) : 0};
+
+          if (roundUp && (i == lastNonNine)) ++digit;
+          if (roundUp && (i > lastNonNine)) digit = 0;
+
+          *position++ = static_cast<char>('0' + digit);
+        }
+      }
+
+      break;
+    }
+  }
+
+  return {position, std::errc{}};
+}
+
 template <class T, class CHECK_T>
 inline constexpr void fraction<T, CHECK_T>::reduce() {
   reduce(numerator, denominator);
@@ -943,7 +2668,7 @@ inline constexpr void fraction<T, CHECK_T>::reduce(T1& numerator, T1& denominato
 
   if (denominator == D_ZERO) throw std::invalid_argument("The denominator must not be 0!");
 
-  const T1 gcd{std::gcd(numerator, denominator)};
+  const T1 gcd{static_cast<T1>(details::gcd(details::magnitude(numerator), details::magnitude(denominator)))};
 
   numerator /= gcd;
   denominator /= gcd;
@@ -956,6 +2681,231 @@ inline constexpr void fraction<T, CHECK_T>::reduce(T1& numerator, T1& denominato
   }
 }
 
+template <class T, class CHECK_T>
+inline constexpr bool fraction<T, CHECK_T>::isNegative(const T& value) noexcept {
+  if constexpr (is_signed)
+    return value < ZERO;
+  else
+    return false;
+}
+
+template <class T, class CHECK_T>
+inline constexpr int fraction<T, CHECK_T>::compare(const fraction<T, CHECK_T>& lhs,
+                                                   const fraction<T, CHECK_T>& rhs) noexcept {
+  const bool lhsNegative{isNegative(lhs.numerator)};
+
+  // Different signs decide right away
+  if (lhsNegative != isNegative(rhs.numerator)) return lhsNegative ? -1 : 1;
+
+  // So do equal denominators
+  if (lhs.denominator == rhs.denominator) return (lhs.numerator < rhs.numerator) ? -1 : (rhs.numerator < lhs.numerator);
+
+  // Integer valued operands only take a single multiplication
+  if (rhs.denominator == ONE) return compareInteger(lhs, rhs.numerator);
+  if (lhs.denominator == ONE) return -compareInteger(rhs, lhs.numerator);
+
+  // Otherwise a single cross multiplication in double width is exact
+  const wide_type lhsProduct{details::multiply(details::magnitude(lhs.numerator), details::magnitude(rhs.denominator))};
+  const wide_type rhsProduct{details::multiply(details::magnitude(rhs.numerator), details::magnitude(lhs.denominator))};
+  const int magnitudeOrder{(lhsProduct < rhsProduct) ? -1 : (rhsProduct < lhsProduct)};
+
+  return lhsNegative ? -magnitudeOrder : magnitudeOrder;
+}
+
+template <class T, class CHECK_T>
+inline constexpr void fraction<T, CHECK_T>::add(const fraction<T, CHECK_T>& rhs, bool subtract) {
+  constexpr unsigned_type U_ONE{1};
+
+  // Fast paths: Zero and integer valued operands
+  if (rhs.numerator == ZERO) return;
+
+  if ((numerator == ZERO) && !subtract) {
+    *this = rhs;
+
+    return;
+  }
+
+  if (rhs.denominator == ONE) {
+    addInteger(rhs.numerator, subtract, false);
+
+    return;
+  }
+
+  if (denominator == ONE) {
+    const T value{numerator};
+
+    *this = rhs;
+    addInteger(value, false, subtract);
+
+    return;
+  }
+
+  const bool lhsNegative{isNegative(numerator)};
+  const bool rhsNegative{isNegative(rhs.numerator) != subtract};
+
+  const unsigned_type lhsDenominator{details::magnitude(denominator)};
+  const unsigned_type rhsDenominator{details::magnitude(rhs.denominator)};
+
+  // Knuth: Only scale both numerators up to the least common denominator. Equal denominators are their own gcd, which
+  // leaves just the small gcd of the sum below
+  const unsigned_type gcd{(lhsDenominator == rhsDenominator) ? lhsDenominator
+                                                             : details::gcd(lhsDenominator, rhsDenominator)};
+  const unsigned_type lhsFactor{static_cast<unsigned_type>(rhsDenominator / gcd)};
+  const unsigned_type rhsFactor{static_cast<unsigned_type>(lhsDenominator / gcd)};
+
+  const wide_type lhsPart{details::multiply(details::magnitude(numerator), lhsFactor)};
+  const wide_type rhsPart{details::multiply(details::magnitude(rhs.numerator), rhsFactor)};
+
+  bool negative{lhsNegative};
+  wide_type sum{};
+
+  if (lhsNegative == rhsNegative) {
+    sum = static_cast<wide_type>(lhsPart + rhsPart);
+
+    // Can only happen for unsigned 64 bit types
+    if (sum < lhsPart) throw std::overflow_error("The result does not fit into the fraction!");
+  } else if (lhsPart >= rhsPart) {
+    sum = static_cast<wide_type>(lhsPart - rhsPart);
+  } else if constexpr (is_unsigned) {
+    // Just like the builtin unsigned types, unsigned fractions wrap around on negative results. The numerator wraps
+    // around over the least common denominator
+    const wide_type lcm{details::multiply(rhsFactor, rhsDenominator)};
+
+    if (lcm > wide_type{std::numeric_limits<unsigned_type>::max()})
+      throw std::overflow_error("The result does not fit into the fraction!");
+
+    numerator = static_cast<T>(unsigned_type{0} - static_cast<unsigned_type>(rhsPart - lhsPart));
+    denominator = static_cast<T>(lcm);
+
+    reduce();
+
+    return;
+  } else {
+    negative = rhsNegative;
+    sum = static_cast<wide_type>(rhsPart - lhsPart);
+  }
+
+  // With coprime denominators the result is already reduced. Otherwise the sum can only share factors with the gcd of
+  // the denominators, so the second gcd runs on small operands
+  unsigned_type sumGcd{U_ONE};
+
+  if (gcd != U_ONE) {
+    sumGcd = details::gcd(gcd, static_cast<unsigned_type>(sum % wide_type{gcd}));
+
+    if (sumGcd != U_ONE) sum = static_cast<wide_type>(sum / wide_type{sumGcd});
+  }
+
+  assignReduced(negative, sum, details::multiply(rhsFactor, static_cast<unsigned_type>(rhsDenominator / sumGcd)));
+}
+
+template <class T, class CHECK_T>
+inline constexpr void fraction<T, CHECK_T>::addInteger(const T& value, bool subtract, bool negate) {
+  const bool lhsNegative{isNegative(numerator) != negate};
+  const bool rhsNegative{isNegative(value) != subtract};
+
+  const unsigned_type magnitudeDenominator{details::magnitude(denominator)};
+
+  const wide_type lhsPart{details::magnitude(numerator)};
+  const wide_type rhsPart{details::multiply(details::magnitude(value), magnitudeDenominator)};
+
+  bool negative{lhsNegative};
+  wide_type sum{};
+
+  // (2^N - 1)^2 + (2^N - 1) < 2^2N, so the sum can't overflow
+  if (lhsNegative == rhsNegative) {
+    sum = static_cast<wide_type>(lhsPart + rhsPart);
+  } else if (lhsPart >= rhsPart) {
+    sum = static_cast<wide_type>(lhsPart - rhsPart);
+  } else {
+    negative = rhsNegative;
+    sum = static_cast<wide_type>(rhsPart - lhsPart);
+  }
+
+  if constexpr (is_unsigned) {
+    // Negative results wrap around just like in operator-=
+    if (negative) {
+      numerator = static_cast<T>(unsigned_type{0} - static_cast<unsigned_type>(sum));
+
+      reduce();
+
+      return;
+    }
+  }
+
+  assignReduced(negative, sum, wide_type{magnitudeDenominator});
+}
+
+template <class T, class CHECK_T>
+inline constexpr void fraction<T, CHECK_T>::multiplyInteger(const T& value) {
+  const unsigned_type lhsNumerator{details::magnitude(numerator)};
+  const unsigned_type lhsDenominator{details::magnitude(denominator)};
+  const unsigned_type rhsValue{details::magnitude(value)};
+
+  const unsigned_type gcd{details::gcd(rhsValue, lhsDenominator)};
+
+  assignReduced(isNegative(numerator) != isNegative(value),
+                details::multiply(lhsNumerator, static_cast<unsigned_type>(rhsValue / gcd)),
+                wide_type{static_cast<unsigned_type>(lhsDenominator / gcd)});
+}
+
+template <class T, class CHECK_T>
+inline constexpr void fraction<T, CHECK_T>::divideInteger(const T& value, bool reciprocal) {
+  if ((reciprocal ? numerator : value) == ZERO) throw std::invalid_argument("The denominator must not be 0!");
+
+  const unsigned_type lhsNumerator{details::magnitude(numerator)};
+  const unsigned_type lhsDenominator{details::magnitude(denominator)};
+  const unsigned_type rhsValue{details::magnitude(value)};
+
+  const unsigned_type gcd{details::gcd(lhsNumerator, rhsValue)};
+  const unsigned_type smallNumerator{static_cast<unsigned_type>(lhsNumerator / gcd)};
+  const wide_type scaledDenominator{details::multiply(lhsDenominator, static_cast<unsigned_type>(rhsValue / gcd))};
+  const bool negative{isNegative(numerator) != isNegative(value)};
+
+  if (reciprocal)
+    assignReduced(negative, scaledDenominator, wide_type{smallNumerator});
+  else
+    assignReduced(negative, wide_type{smallNumerator}, scaledDenominator);
+}
+
+template <class T, class CHECK_T>
+inline constexpr int fraction<T, CHECK_T>::compareInteger(const fraction<T, CHECK_T>& lhs, const T& value) noexcept {
+  const bool lhsNegative{isNegative(lhs.numerator)};
+
+  if (lhsNegative != isNegative(value)) return lhsNegative ? -1 : 1;
+
+  const wide_type lhsPart{details::magnitude(lhs.numerator)};
+  const wide_type rhsPart{details::multiply(details::magnitude(value), details::magnitude(lhs.denominator))};
+  const int magnitudeOrder{(lhsPart < rhsPart) ? -1 : (rhsPart < lhsPart)};
+
+  return lhsNegative ? -magnitudeOrder : magnitudeOrder;
+}
+
+template <class T, class CHECK_T>
+inline constexpr void fraction<T, CHECK_T>::assignReduced(bool negative, const wide_type& numerator,
+                                                          const wide_type& denominator) {
+  constexpr wide_type W_ZERO{0};
+  constexpr wide_type MAX_POSITIVE{static_cast<unsigned_type>(std::numeric_limits<T>::max())};
+  constexpr wide_type MAX_NEGATIVE{is_signed ? static_cast<wide_type>(MAX_POSITIVE + wide_type{1}) : W_ZERO};
+
+  if (denominator == W_ZERO) throw std::invalid_argument("The denominator must not be 0!");
+
+  if (numerator == W_ZERO) {
+    this->numerator = ZERO;
+    this->denominator = ONE;
+
+    return;
+  }
+
+  if ((denominator > MAX_POSITIVE) || (numerator > (negative ? MAX_NEGATIVE : MAX_POSITIVE)))
+    throw std::overflow_error("The result does not fit into the fraction!");
+
+  const unsigned_type narrowNumerator{static_cast<unsigned_type>(numerator)};
+
+  this->numerator = static_cast<T>(negative ? static_cast<unsigned_type>(unsigned_type{0} - narrowNumerator)
+                                            : narrowNumerator);
+  this->denominator = static_cast<T>(static_cast<unsigned_type>(denominator));
+}
+
 namespace std {
 template <class T, class CHECK_T>
 constexpr fraction<T, CHECK_T> numeric_limits<fraction<T, CHECK_T>>::min() noexcept {
@@ -1001,6 +2951,112 @@ template <class T, class CHECK_T>
 constexpr fraction<T, CHECK_T> numeric_limits<fraction<T, CHECK_T>>::denorm_min() noexcept {
   return fraction<T, CHECK_T>{};
 }
+
+template <class T, class CHECK_T>
+constexpr size_t hash<fraction<T, CHECK_T>>::operator()(const fraction<T, CHECK_T>& value) const noexcept {
+  return details::hashFraction(value.getNumerator(), value.getDenominator());
+}
+
+#ifdef FRACTION_HAS_FORMAT
+template <class T, class CHECK_T, class charT>
+constexpr typename basic_format_parse_context<charT>::iterator formatter<fraction<T, CHECK_T>, charT>::parse(
+    basic_format_parse_context<charT>& context) {
+  const auto isAlign = [](charT value) {
+    return (value == charT{'<'}) || (value == charT{'^'}) || (value == charT{'>'});
+  };
+
+  auto position{context.begin()};
+  const auto end{context.end()};
+
+  // Empty format spec. The '}' closes the replacement field, even if an alignment follows it
+  if ((position == end) || (*position == charT{'}'})) return position;
+
+  if ((std::next(position) != end) && isAlign(*std::next(position))) {
+    if (*position == charT{'{'}) throw format_error("Invalid fill character for a fraction!");
+
+    fill = *position++;
+    align = *position++;
+  } else if (isAlign(*position)) {
+    align = *position++;
+  }
+
+  if ((position != end) && ((*position == charT{'+'}) || (*position == charT{'-'}) || (*position == charT{' '}) ||
+                            (*position == charT{'#'}) || (*position == charT{'0'})))
+    throw format_error("Fractions don't support the sign, # and 0 options!");
+
+  for (; (position != end) && (*position >= charT{'0'}) && (*position <= charT{'9'}); ++position) {
+    if (width > 100'000) throw format_error("The width of a fraction is too large!");
+
+    width = (width * 10) + static_cast<std::size_t>(*position - charT{'0'});
+  }
+
+  if ((position != end) && (*position == charT{'.'})) {
+    precision = 0;
+
+    for (++position; (position != end) && (*position >= charT{'0'}) && (*position <= charT{'9'}); ++position) {
+      if (precision > 100'000) throw format_error("The precision of a fraction is too large!");
+
+      precision = (precision * 10) + static_cast<int>(*position - charT{'0'});
+    }
+  }
+
+  if ((position != end) && (*position == charT{'{'}))
+    throw format_error("Fractions don't support widths or precisions given as arguments!");
+
+  if ((position != end) && (*position != charT{'}'})) {
+    switch (*position++) {
+      case charT{'c'}:
+        charsFormat = fraction_chars_format::compact;
+        break;
+      case charT{'m'}:
+        charsFormat = fraction_chars_format::mixed;
+        break;
+      case charT{'f'}:
+        charsFormat = fraction_chars_format::fixed;
+        break;
+      default:
+        throw format_error("Invalid format type for a fraction!");
+    }
+  }
+
+  if ((position != end) && (*position != charT{'}'})) throw format_error("Invalid format spec for a fraction!");
+  if ((precision >= 0) && (charsFormat != fraction_chars_format::fixed))
+    throw format_error("Only the fixed format of a fraction takes a precision!");
+
+  return position;
+}
+
+template <class T, class CHECK_T, class charT>
+template <class FormatContext>
+typename FormatContext::iterator formatter<fraction<T, CHECK_T>, charT>::format(const fraction<T, CHECK_T>& value,
+                                                                                 FormatContext& context) const {
+  // Sign, the integer part and the point need far less than the spare room
+  constexpr std::size_t STACK_SIZE{128};
+  constexpr std::size_t SPARE{64};
+
+  char stackBuffer[STACK_SIZE];
+  std::string heapBuffer;
+  char* first{stackBuffer};
+  char* last{stackBuffer + STACK_SIZE};
+
+  if ((precision >= 0) && (static_cast<std::size_t>(precision) > (STACK_SIZE - SPARE))) {
+    heapBuffer.resize(static_cast<std::size_t>(precision) + SPARE);
+    first = heapBuffer.data();
+    last = first + heapBuffer.size();
+  }
+
+  const to_chars_result result{::to_chars(first, last, value, charsFormat, precision)};
+  const std::size_t length{static_cast<std::size_t>(result.ptr - first)};
+  const std::size_t padding{(width > length) ? (width - length) : 0};
+  const std::size_t before{(align == charT{'<'}) ? 0 : ((align == charT{'^'}) ? (padding / 2) : padding)};
+
+  // The output is plain ASCII, so every char is one code unit of any charT
+  auto out{std::fill_n(context.out(), before, fill)};
+  out = std::copy(first, result.ptr, out);
+
+  return std::fill_n(out, padding - before, fill);
+}
+#endif
 }  // namespace std
 
 #endif  // !FRACTION_FRACTION_HPP_
@@ -0,0 +1,807 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#pragma once
+#ifndef FRACTION_FRACTION_BATCH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+#include "fraction.hpp"
+
+#if defined(__AVX2__) && !defined(FRACTION_NO_SIMD)
+#include <immintrin.h>
+
+#define FRACTION_HAS_AVX2
+#endif
+
+////////////////////////////////////////////////////////////
+// Details
+////////////////////////////////////////////////////////////
+
+namespace details {
+/*!
+ * @brief Reduces a single numerator and denominator pair. Same as the reduction of @c fraction
+ *
+ * @throws std::invalid_argument when @p denominator is 0.
+ * @throws std::overflow_error when moving the sign of the denominator would negate the minimum of @p T.
+ */
+template <class T>
+constexpr void reduceOne(T& numerator, T& denominator) {
+  if (denominator == T{0}) throw std::invalid_argument("The denominator must not be 0!");
+
+  const T gcd{static_cast<T>(details::gcd(details::magnitude(numerator), details::magnitude(denominator)))};
+
+  numerator /= gcd;
+  denominator /= gcd;
+
+  if constexpr (std::is_signed<T>::value) {
+    if (denominator < T{0}) {
+      if ((numerator == std::numeric_limits<T>::min()) || (denominator == std::numeric_limits<T>::min()))
+        throw std::overflow_error("The result does not fit into the fraction!");
+
+      numerator = -numerator;
+      denominator = -denominator;
+    }
+  }
+}
+
+template <class T>
+constexpr void reduceBatchScalar(T* numerators, T* denominators, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i)
+    reduceOne(numerators[i], denominators[i]);
+}
+
+/// Product of two double width values. Returns @c false instead when it overflows
+template <class W>
+constexpr bool multiplyChecked(const W& lhs, const W& rhs, W& product) noexcept {
+  constexpr W HALF_MAX{static_cast<W>((W{1} << (static_cast<int>(sizeof(W)) * 4)) - W{1})};
+  constexpr W MAX{static_cast<W>(W{0} - W{1})};
+
+  // Common case: Both factors fit into half the width
+  if (((lhs > HALF_MAX) || (rhs > HALF_MAX)) && (lhs != W{0}) && (rhs > static_cast<W>(MAX / lhs))) return false;
+
+  product = static_cast<W>(lhs * rhs);
+
+  return true;
+}
+
+/// Product of two values of @p T. Returns @c false instead when it doesn't fit into @p T
+template <class T>
+constexpr bool multiplyInto(const T& lhs, const T& rhs, T& product) noexcept {
+  typedef typename std::make_unsigned<T>::type U;
+
+  bool negative{false};
+
+  if constexpr (std::is_signed<T>::value) negative = (lhs < T{0}) != (rhs < T{0});
+
+  const wide_t<U> full{multiply(magnitude(lhs), magnitude(rhs))};
+  const U limit{negative ? magnitude(std::numeric_limits<T>::min()) : static_cast<U>(std::numeric_limits<T>::max())};
+
+  if (wide_t<U>{limit} < full) return false;
+
+  const U result{static_cast<U>(full)};
+
+  product = negative ? static_cast<T>(U{0} - result) : static_cast<T>(result);
+
+  return true;
+}
+
+/// Sum or difference of two values of @p T. Returns @c false instead when it doesn't fit into @p T
+template <class T>
+constexpr bool addInto(const T& lhs, const T& rhs, bool subtract, T& sum) noexcept {
+  constexpr T MIN{std::numeric_limits<T>::min()};
+  constexpr T MAX{std::numeric_limits<T>::max()};
+
+  if constexpr (std::is_signed<T>::value) {
+    if (subtract ? ((rhs < T{0}) ? (lhs > (MAX + rhs)) : (lhs < (MIN + rhs)))
+                 : ((rhs > T{0}) ? (lhs > (MAX - rhs)) : (lhs < (MIN - rhs))))
+      return false;
+  } else {
+    if (subtract ? (lhs < rhs) : (lhs > (MAX - rhs))) return false;
+  }
+
+  sum = static_cast<T>(subtract ? (lhs - rhs) : (lhs + rhs));
+
+  return true;
+}
+
+/*!
+ * @brief Running sum of fractions in double width
+ *
+ * Numerator and denominator are kept in @c wide_t<T>, so a sum over values sharing the same few denominators (or any
+ * short sum) never needs to reduce. The accumulator only reduces when the next step would overflow even the double
+ * width, and only the final result has to fit into @p T.
+ *
+ * @tparam T       Integer type of the fractions to sum up
+ * @tparam CHECK_T Used for checking if @p T is an integer type
+ */
+template <class T, class CHECK_T>
+class wide_accumulator {
+ public:
+  typedef fraction<T, CHECK_T> fraction_type;
+  typedef wide_t<T> wide_type;
+
+ private:
+  bool negative{false};
+  wide_type numerator{0};
+  wide_type denominator{1};
+
+ public:
+  /// Adds @p value
+  constexpr void add(const fraction_type& value);
+  /// Adds @p lhs * @p rhs without reducing the product
+  constexpr void addProduct(const fraction_type& lhs, const fraction_type& rhs);
+
+  /*!
+   * @brief Reduced sum as a fraction
+   *
+   * @throws std::overflow_error when the sum doesn't fit into @p T.
+   */
+  constexpr fraction_type result() const;
+
+ private:
+  /*!
+   * @brief Adds a fraction given in double width
+   *
+   * @throws std::overflow_error when even the reduced sum needs more than double the width of @p T.
+   */
+  constexpr void add(bool negative, wide_type numerator, wide_type denominator);
+
+  /// Adds in place if nothing overflows. Leaves everything untouched and returns @c false otherwise
+  constexpr bool tryAdd(bool negative, const wide_type& numerator, const wide_type& denominator);
+
+  static constexpr void reduce(wide_type& numerator, wide_type& denominator);
+};
+
+template <class T, class CHECK_T>
+inline constexpr void wide_accumulator<T, CHECK_T>::add(const fraction_type& value) {
+  add(fraction_type::isNegative(value.numerator), wide_type{magnitude(value.numerator)},
+      wide_type{magnitude(value.denominator)});
+}
+
+template <class T, class CHECK_T>
+inline constexpr void wide_accumulator<T, CHECK_T>::addProduct(const fraction_type& lhs, const fraction_type& rhs) {
+  add(fraction_type::isNegative(lhs.numerator) != fraction_type::isNegative(rhs.numerator),
+      multiply(magnitude(lhs.numerator), magnitude(rhs.numerator)),
+      multiply(magnitude(lhs.denominator), magnitude(rhs.denominator)));
+}
+
+template <class T, class CHECK_T>
+inline constexpr typename wide_accumulator<T, CHECK_T>::fraction_type wide_accumulator<T, CHECK_T>::result() const {
+  wide_type reducedNumerator{numerator};
+  wide_type reducedDenominator{denominator};
+
+  reduce(reducedNumerator, reducedDenominator);
+
+  fraction_type out{};
+
+  out.assignReduced(negative, reducedNumerator, reducedDenominator);
+
+  return out;
+}
+
+template <class T, class CHECK_T>
+inline constexpr void wide_accumulator<T, CHECK_T>::add(bool negative, wide_type numerator, wide_type denominator) {
+  if (tryAdd(negative, numerator, denominator)) return;
+
+  // Only reduce once the double width doesn't suffice anymore
+  reduce(this->numerator, this->denominator);
+  reduce(numerator, denominator);
+
+  if (!tryAdd(negative, numerator, denominator))
+    throw std::overflow_error("The result does not fit into the fraction!");
+}
+
+template <class T, class CHECK_T>
+inline constexpr bool wide_accumulator<T, CHECK_T>::tryAdd(bool negative, const wide_type& numerator,
+                                                          const wide_type& denominator) {
+  wide_type lhsFactor{1};
+  wide_type rhsFactor{1};
+  wide_type commonDenominator{this->denominator};
+
+  // Shared denominators and denominators dividing each other are the common case and need no gcd
+  if (this->denominator == denominator) {
+  } else if ((this->denominator % denominator) == wide_type{0}) {
+    rhsFactor = static_cast<wide_type>(this->denominator / denominator);
+  } else if ((denominator % this->denominator) == wide_type{0}) {
+    lhsFactor = static_cast<wide_type>(denominator / this->denominator);
+    commonDenominator = denominator;
+  } else {
+    const wide_type gcd{details::gcd(this->denominator, denominator)};
+
+    lhsFactor = static_cast<wide_type>(denominator / gcd);
+    rhsFactor = static_cast<wide_type>(this->denominator / gcd);
+
+    if (!multiplyChecked(this->denominator, lhsFactor, commonDenominator)) return false;
+  }
+
+  wide_type lhsPart{};
+  wide_type rhsPart{};
+
+  if (!multiplyChecked(this->numerator, lhsFactor, lhsPart) || !multiplyChecked(numerator, rhsFactor, rhsPart))
+    return false;
+
+  if (this->negative == negative) {
+    const wide_type sum{static_cast<wide_type>(lhsPart + rhsPart)};
+
+    if (sum < lhsPart) return false;
+
+    this->numerator = sum;
+  } else if (lhsPart >= rhsPart) {
+    this->numerator = static_cast<wide_type>(lhsPart - rhsPart);
+  } else {
+    this->negative = negative;
+    this->numerator = static_cast<wide_type>(rhsPart - lhsPart);
+  }
+
+  this->denominator = commonDenominator;
+
+  return true;
+}
+
+template <class T, class CHECK_T>
+inline constexpr void wide_accumulator<T, CHECK_T>::reduce(wide_type& numerator, wide_type& denominator) {
+  const wide_type gcd{details::gcd(numerator, denominator)};
+
+  numerator = static_cast<wide_type>(numerator / gcd);
+  denominator = static_cast<wide_type>(denominator / gcd);
+}
+
+/// Access to the internals of @c fraction for the batch kernels
+template <class T, class CHECK_T>
+struct batch_access {
+  typedef fraction<T, CHECK_T> fraction_type;
+
+  /// Builds a fraction from a numerator and a positive denominator that are coprime already
+  static constexpr fraction_type makeReduced(const T& numerator, const T& denominator) noexcept {
+    return fraction_type{numerator, denominator, typename fraction_type::reduced_tag{}};
+  }
+};
+
+/// Number of values a leaf of the reduction tree combines sequentially
+constexpr std::size_t treeLeafSize{1024};
+/// Smallest range worth starting another thread for
+constexpr std::size_t treeMinParallelSize{16 * treeLeafSize};
+
+/*!
+ * @brief Reduces a range in a balanced binary tree
+ *
+ * The range is halved until the pieces are no longer than @c treeLeafSize. The leaves are reduced with @p leaf and the
+ * results are merged pairwise with @p merge. This keeps the operands of every merge about the same size, instead of
+ * merging a small value into an ever growing one.\n
+ * The top levels of the tree run on up to @p threads threads. The shape of the tree only depends on @p count, so the
+ * result and whether it throws don't depend on the number of threads.
+ */
+template <class R, class LEAF, class MERGE>
+R treeReduce(std::size_t begin, std::size_t count, unsigned int threads, const LEAF& leaf, const MERGE& merge) {
+  if (count <= treeLeafSize) return leaf(begin, count);
+
+  const std::size_t half{count / 2};
+
+  if ((threads < 2) || (count < treeMinParallelSize))
+    return merge(treeReduce<R>(begin, half, 1, leaf, merge), treeReduce<R>(begin + half, count - half, 1, leaf, merge));
+
+  const unsigned int lowerThreads{threads / 2};
+  std::future<R> lower{std::async(std::launch::async, [&]() {
+    return treeReduce<R>(begin, half, lowerThreads, leaf, merge);
+  })};
+  const R upper{treeReduce<R>(begin + half, count - half, threads - lowerThreads, leaf, merge)};
+
+  return merge(lower.get(), upper);
+}
+
+/// Number of threads to use when @p threads threads were requested. 0 requests all cores
+inline unsigned int threadCount(unsigned int threads) noexcept {
+  if (threads != 0) return threads;
+
+  const unsigned int cores{std::thread::hardware_concurrency()};
+
+  return (cores == 0) ? 1 : cores;
+}
+
+#ifdef FRACTION_HAS_AVX2
+/// Number of trailing zero bits of each lane, read from the exponent of the lowest set bit converted to float. Lanes
+/// that are 0 yield a huge count, which makes the variable shifts produce 0
+inline __m256i countTrailingZerosAvx2(__m256i value) noexcept {
+  const __m256i lowestBit{_mm256_and_si256(value, _mm256_sub_epi32(_mm256_setzero_si256(), value))};
+  const __m256i exponent{_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(lowestBit)), 23)};
+
+  return _mm256_sub_epi32(_mm256_and_si256(exponent, _mm256_set1_epi32(0xFF)), _mm256_set1_epi32(127));
+}
+
+/// Exact quotients of 8 lanes, which are known to divide evenly. Doubles represent all operands and quotients exactly
+inline __m256i divideExactAvx2(__m256i dividend, __m256i divisor) noexcept {
+  const __m256d low{_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(dividend)),
+                                  _mm256_cvtepi32_pd(_mm256_castsi256_si128(divisor)))};
+  const __m256d high{_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(dividend, 1)),
+                                   _mm256_cvtepi32_pd(_mm256_extracti128_si256(divisor, 1)))};
+
+  return _mm256_set_m128i(_mm256_cvttpd_epi32(high), _mm256_cvttpd_epi32(low));
+}
+
+/// Converts 4 signed 64 bit lanes of at most 2^53 in magnitude to double, which is exact. AVX2 has no instruction for
+/// it, so the signed upper and the unsigned lower 32 bits are converted separately. Every partial sum is exact as well,
+/// so fast math flags can't change the result by reordering them
+inline __m256d int64ToDoubleAvx2(__m256i value) noexcept {
+  // Lower halves into the lower 128 bits, upper halves into the upper 128 bits
+  const __m256i split{_mm256_permutevar8x32_epi32(value, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7))};
+
+  const __m128i topBit{_mm_set1_epi32(std::numeric_limits<std::int32_t>::min())};
+  const __m128i upper{_mm256_extracti128_si256(split, 1)};
+  // Flipping the top bit turns the unsigned lower half into a signed one that is 2^31 smaller
+  const __m128i lower{_mm_xor_si128(_mm256_castsi256_si128(split), topBit)};
+
+  const __m256d high{_mm256_mul_pd(_mm256_cvtepi32_pd(upper), _mm256_set1_pd(4294967296.0))};
+  const __m256d low{_mm256_add_pd(_mm256_cvtepi32_pd(lower), _mm256_set1_pd(2147483648.0))};
+
+  return _mm256_add_pd(high, low);
+}
+
+/// Converts 4 fractions of 32 bit integers to double, like @c operator D(). Doubles hold all operands exactly, so the
+/// division is the only rounding
+inline bool toDoubleBlockAvx2(const std::int32_t* pairs, double* values) noexcept {
+  // Numerators into the lower half, denominators into the upper half
+  const __m256i split{_mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs)),
+                                                  _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7))};
+
+  _mm256_storeu_pd(values, _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(split)),
+                                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(split, 1))));
+
+  return true;
+}
+
+/*!
+ * @brief Converts 4 fractions of 64 bit integers to double, like @c operator D()
+ *
+ * @returns @c false if any numerator or denominator is beyond 2^53, where converting it to double rounds already.
+ * Nothing is stored in that case.
+ */
+inline bool toDoubleBlockAvx2(const std::int64_t* pairs, double* values) noexcept {
+  const __m256i limit{_mm256_set1_epi64x(std::int64_t{1} << 53)};
+  const __m256i negativeLimit{_mm256_set1_epi64x(-(std::int64_t{1} << 53))};
+
+  const __m256i first{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs))};
+  const __m256i second{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs + 4))};
+
+  const __m256i outOfRange{_mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpgt_epi64(first, limit), _mm256_cmpgt_epi64(negativeLimit, first)),
+      _mm256_or_si256(_mm256_cmpgt_epi64(second, limit), _mm256_cmpgt_epi64(negativeLimit, second)))};
+
+  if (!_mm256_testz_si256(outOfRange, outOfRange)) return false;
+
+  // Both are in the order 0, 2, 1, 3
+  const __m256d numerators{int64ToDoubleAvx2(_mm256_unpacklo_epi64(first, second))};
+  const __m256d denominators{int64ToDoubleAvx2(_mm256_unpackhi_epi64(first, second))};
+
+  _mm256_storeu_pd(values, _mm256_permute4x64_pd(_mm256_div_pd(numerators, denominators), 0xD8));
+
+  return true;
+}
+
+/*!
+ * @brief Runs the continued fraction loop of the floating point constructor on 4 values at once
+ *
+ * All convergents fit into 32 bits, so doubles hold them exactly and every step gives the same result as the scalar
+ * loop. Lanes are masked out once they meet the precision.
+ *
+ * @param[in]  maxPositive  Largest value of the target integer type
+ * @param[in]  allowNegative Whether the target integer type is signed
+ * @param[out] numerators   Signed numerators of the results
+ * @param[out] denominators Denominators of the results
+ *
+ * @returns A bit mask of the lanes the scalar constructor has to handle. Those are NaN, values out of range and values
+ * whose loop would end with a convergent that doesn't fit.
+ */
+inline int fromDoubleBlockAvx2(const double* values, double precision, double maxPositive, bool allowNegative,
+                               double* numerators, double* denominators) noexcept {
+  const __m256d zero{_mm256_setzero_pd()};
+  const __m256d one{_mm256_set1_pd(1.0)};
+  const __m256d signBit{_mm256_set1_pd(-0.0)};
+  const __m256d max{_mm256_set1_pd(maxPositive)};
+  const __m256d precisionVector{_mm256_set1_pd(precision)};
+
+  const __m256d value{_mm256_loadu_pd(values)};
+  const __m256d posValue{_mm256_andnot_pd(signBit, value)};
+
+  // The integer part of the value has to fit
+  __m256d fallback{_mm256_cmp_pd(posValue, _mm256_add_pd(max, one), _CMP_NLT_UQ)};
+
+  // NaN and infinity are checked by their bits, since fast math flags let the compiler assume they don't exist
+  fallback = _mm256_or_pd(fallback, _mm256_castsi256_pd(_mm256_cmpgt_epi64(
+                                        _mm256_castpd_si256(posValue), _mm256_set1_epi64x(0x7FEFFFFFFFFFFFFF))));
+
+  if (!allowNegative) fallback = _mm256_or_pd(fallback, _mm256_cmp_pd(value, zero, _CMP_LT_OQ));
+
+  __m256d active{_mm256_andnot_pd(fallback, _mm256_castsi256_pd(_mm256_set1_epi32(-1)))};
+  __m256d rest{posValue};
+  __m256d n1{one};
+  __m256d n2{zero};
+  __m256d d1{zero};
+  __m256d d2{one};
+  __m256d resultNumerator{zero};
+  __m256d resultDenominator{one};
+
+  while (_mm256_movemask_pd(active) != 0) {
+    const __m256d digit{_mm256_round_pd(rest, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)};
+    const __m256d nextN1{_mm256_add_pd(_mm256_mul_pd(digit, n1), n2)};
+    const __m256d nextD1{_mm256_add_pd(_mm256_mul_pd(digit, d1), d2)};
+
+    // Left to the scalar code, which knows what to use instead
+    const __m256d overflow{_mm256_and_pd(
+        active, _mm256_or_pd(_mm256_cmp_pd(nextN1, max, _CMP_GT_OQ), _mm256_cmp_pd(nextD1, max, _CMP_GT_OQ)))};
+
+    fallback = _mm256_or_pd(fallback, overflow);
+    active = _mm256_andnot_pd(overflow, active);
+
+    n2 = _mm256_blendv_pd(n2, n1, active);
+    n1 = _mm256_blendv_pd(n1, nextN1, active);
+    d2 = _mm256_blendv_pd(d2, d1, active);
+    d1 = _mm256_blendv_pd(d1, nextD1, active);
+
+    const __m256d fractionalPart{_mm256_sub_pd(rest, digit)};
+    const __m256d error{_mm256_andnot_pd(signBit, _mm256_sub_pd(_mm256_div_pd(n1, d1), posValue))};
+    const __m256d finished{_mm256_and_pd(active, _mm256_or_pd(_mm256_cmp_pd(error, precisionVector, _CMP_LE_OQ),
+                                                              _mm256_cmp_pd(fractionalPart, zero, _CMP_EQ_OQ)))};
+
+    resultNumerator = _mm256_blendv_pd(resultNumerator, n1, finished);
+    resultDenominator = _mm256_blendv_pd(resultDenominator, d1, finished);
+    active = _mm256_andnot_pd(finished, active);
+
+    rest = _mm256_blendv_pd(rest, _mm256_div_pd(one, fractionalPart), active);
+
+    // The next digit alone would overflow
+    const __m256d hugeDigit{_mm256_and_pd(active, _mm256_cmp_pd(rest, max, _CMP_NLT_UQ))};
+
+    fallback = _mm256_or_pd(fallback, hugeDigit);
+    active = _mm256_andnot_pd(hugeDigit, active);
+  }
+
+  // Copy the sign of the value
+  _mm256_storeu_pd(numerators, _mm256_or_pd(resultNumerator, _mm256_and_pd(value, signBit)));
+  _mm256_storeu_pd(denominators, resultDenominator);
+
+  return _mm256_movemask_pd(fallback);
+}
+
+/*!
+ * @brief Reduces 8 fractions at once
+ *
+ * Runs Stein's binary gcd on all lanes in lockstep. Lanes that are done already are masked out, so the loop is free of
+ * branches per lane and runs as long as the slowest lane.
+ *
+ * @returns @c false if any denominator is 0 or any result overflows. Nothing is stored in that case.
+ */
+inline bool reduceBlockAvx2(std::int32_t* numerators, std::int32_t* denominators) noexcept {
+  const __m256i zero{_mm256_setzero_si256()};
+
+  const __m256i numerator{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(numerators))};
+  const __m256i denominator{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(denominators))};
+
+  if (!_mm256_testz_si256(_mm256_cmpeq_epi32(denominator, zero), _mm256_cmpeq_epi32(denominator, zero))) return false;
+
+  // The absolute value of the minimum is its correct magnitude as an unsigned value
+  __m256i u{_mm256_abs_epi32(denominator)};
+  __m256i v{_mm256_abs_epi32(numerator)};
+
+  const __m256i commonShift{countTrailingZerosAvx2(_mm256_or_si256(u, v))};
+
+  // u is never 0, since the denominator isn't
+  u = _mm256_srlv_epi32(u, countTrailingZerosAvx2(u));
+
+  while (!_mm256_testz_si256(v, v)) {
+    const __m256i active{_mm256_xor_si256(_mm256_cmpeq_epi32(v, zero), _mm256_set1_epi32(-1))};
+
+    v = _mm256_srlv_epi32(v, countTrailingZerosAvx2(v));
+
+    const __m256i smaller{_mm256_min_epu32(u, v)};
+    const __m256i larger{_mm256_max_epu32(u, v)};
+
+    u = _mm256_blendv_epi8(u, smaller, active);
+    v = _mm256_and_si256(_mm256_sub_epi32(larger, smaller), active);
+  }
+
+  const __m256i gcd{_mm256_sllv_epi32(u, commonShift)};
+
+  __m256i reducedNumerator{divideExactAvx2(numerator, gcd)};
+  __m256i reducedDenominator{divideExactAvx2(denominator, gcd)};
+
+  // Negating the minimum would overflow, in the numerator as well as in the denominator
+  const __m256i minValue{_mm256_set1_epi32(std::numeric_limits<std::int32_t>::min())};
+  const __m256i negative{_mm256_cmpgt_epi32(zero, reducedDenominator)};
+  const __m256i minimum{_mm256_or_si256(_mm256_cmpeq_epi32(reducedNumerator, minValue),
+                                        _mm256_cmpeq_epi32(reducedDenominator, minValue))};
+
+  if (!_mm256_testz_si256(negative, minimum)) return false;
+
+  reducedNumerator = _mm256_sign_epi32(reducedNumerator, _mm256_or_si256(reducedDenominator, _mm256_set1_epi32(1)));
+  reducedDenominator = _mm256_abs_epi32(reducedDenominator);
+
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(numerators), reducedNumerator);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(denominators), reducedDenominator);
+
+  return true;
+}
+#endif
+}  // namespace details
+
+////////////////////////////////////////////////////////////
+// Declarations
+////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Reduces many fractions stored as separate arrays of numerators and denominators
+ *
+ * Gives the same results as constructing a @c fraction from every pair, but works on whole columns at once. For
+ * @c std::int32_t the fractions are reduced 8 at a time with AVX2 when the compiler targets it (unless
+ * @c FRACTION_NO_SIMD is defined). All other types and the remaining elements use the scalar code.
+ *
+ * @tparam        T            Integer type of numerators and denominators
+ * @tparam        CHECK_T      Used for checking if @p T is an integer type
+ * @param[in,out] numerators   Array of @p count numerators
+ * @param[in,out] denominators Array of @p count denominators
+ * @param[in]     count        Number of fractions
+ *
+ * @throws std::invalid_argument when a denominator is 0.
+ * @throws std::overflow_error when a reduced fraction doesn't fit into @p T.
+ *
+ * Fractions before the one that caused the exception might already be reduced.
+ */
+template <class T, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+void reduceBatch(T* numerators, T* denominators, std::size_t count);
+
+/*!
+ * @brief Converts @p count fractions to a floating point type
+ *
+ * Gives the same correctly rounded results as @c operator D(). For @c double and 32 or 64 bit signed integers 4
+ * fractions are converted at a time with AVX2 when the compiler targets it (unless @c FRACTION_NO_SIMD is defined).
+ * Blocks with 64 bit values beyond 2^53 use the scalar conversion.
+ */
+template <class T, class CHECK_T, class D,
+          class CHECK_D = typename std::enable_if<std::is_floating_point<D>::value>::type>
+void toFloatingPointBatch(const fraction<T, CHECK_T>* values, D* out, std::size_t count) noexcept;
+
+/*!
+ * @brief Converts @p count floating point values to fractions
+ *
+ * Gives the same results as the floating point constructor with @p precison. For @c double and 32 bit integers the
+ * continued fraction loop runs on 4 values at a time with AVX2 when the compiler targets it (unless
+ * @c FRACTION_NO_SIMD is defined). Values the vector loop can't handle exactly like the constructor fall back to it.
+ *
+ * @throws std::invalid_argument and std::overflow_error like the floating point constructor. Values before the one
+ * that caused the exception have been converted already.
+ */
+template <class D, class T, class CHECK_T,
+          class CHECK_D = typename std::enable_if<std::is_floating_point<D>::value>::type>
+void fromFloatingPointBatch(const D* values, fraction<T, CHECK_T>* out, std::size_t count, const D& precison = D{0});
+
+/*!
+ * @brief Converts @p count floating point values to the closest fractions with a denominator of at most
+ * @p maxDenominator
+ *
+ * Same as calling @c fraction::limitDenominator on every value.
+ *
+ * @throws std::invalid_argument and std::overflow_error like @c fraction::limitDenominator. Values before the one that
+ * caused the exception have been converted already.
+ */
+template <class D, class T, class CHECK_T,
+          class CHECK_D = typename std::enable_if<std::is_floating_point<D>::value>::type>
+void limitDenominatorBatch(const D* values, fraction<T, CHECK_T>* out, std::size_t count, const T& maxDenominator);
+
+/*!
+ * @brief Sum of @p count fractions
+ *
+ * Unlike adding them up with @c operator+=, the running sum is kept unreduced in double width. It's only reduced when
+ * the double width doesn't suffice, and once at the end.
+ *
+ * @throws std::overflow_error when the sum doesn't fit into @p T, or an intermediate sum needs more than double the
+ * width of @p T even after reducing it.
+ */
+template <class T, class CHECK_T>
+constexpr fraction<T, CHECK_T> fractionSum(const fraction<T, CHECK_T>* values, std::size_t count);
+
+/*!
+ * @brief Dot product of two arrays of @p count fractions
+ *
+ * The products are added up unreduced, like in @c fractionSum.
+ *
+ * @throws std::overflow_error when the result doesn't fit into @p T, or an intermediate sum needs more than double the
+ * width of @p T even after reducing it.
+ */
+template <class T, class CHECK_T>
+constexpr fraction<T, CHECK_T> fractionDot(const fraction<T, CHECK_T>* lhs, const fraction<T, CHECK_T>* rhs,
+                                           std::size_t count);
+
+/*!
+ * @brief Sum of @p count fractions on up to @p threads threads
+ *
+ * The range is summed up in a balanced tree. Each leaf is summed up like in @c fractionSum and the partial sums are
+ * added pairwise, which keeps the denominators of long sums small. The result is the same for any number of threads.
+ *
+ * @param threads Maximum number of threads to use. 0 uses all cores
+ * @throws std::overflow_error when the sum or a partial sum doesn't fit into @p T.
+ */
+template <class T, class CHECK_T>
+fraction<T, CHECK_T> fractionSum(const fraction<T, CHECK_T>* values, std::size_t count, unsigned int threads);
+
+/// Product of @p count fractions
+template <class T, class CHECK_T>
+constexpr fraction<T, CHECK_T> fractionProduct(const fraction<T, CHECK_T>* values, std::size_t count);
+
+/*!
+ * @brief Product of @p count fractions on up to @p threads threads
+ *
+ * Same balanced tree as the parallel @c fractionSum.
+ *
+ * @param threads Maximum number of threads to use. 0 uses all cores
+ * @throws std::overflow_error when the product or a partial product doesn't fit into @p T.
+ */
+template <class T, class CHECK_T>
+fraction<T, CHECK_T> fractionProduct(const fraction<T, CHECK_T>* values, std::size_t count, unsigned int threads);
+
+/*!
+ * @brief Computes @p y = @p factor * @p x + @p y element wise
+ *
+ * Every element is computed in double width and reduced only once, instead of once for the product and once for the
+ * sum.
+ *
+ * @throws std::overflow_error when an element doesn't fit into @p T. Elements before it have been updated already.
+ */
+template <class T, class CHECK_T>
+constexpr void fractionAxpy(const fraction<T, CHECK_T>& factor, const fraction<T, CHECK_T>* x,
+                            fraction<T, CHECK_T>* y, std::size_t count);
+
+////////////////////////////////////////////////////////////
+// Implementation
+////////////////////////////////////////////////////////////
+
+template <class T, class CHECK_T>
+inline void reduceBatch(T* numerators, T* denominators, std::size_t count) {
+  std::size_t done{0};
+
+#ifdef FRACTION_HAS_AVX2
+  if constexpr (std::is_same<T, std::int32_t>::value) {
+    constexpr std::size_t lanes{8};
+
+    // A failing block is left untouched and the scalar code throws the matching exception below
+    for (; (done + lanes) <= count; done += lanes) {
+      if (!details::reduceBlockAvx2(numerators + done, denominators + done)) break;
+    }
+  }
+#endif
+
+  details::reduceBatchScalar(numerators + done, denominators + done, count - done);
+}
+
+template <class T, class CHECK_T, class D, class CHECK_D>
+inline void toFloatingPointBatch(const fraction<T, CHECK_T>* values, D* out, std::size_t count) noexcept {
+  std::size_t done{0};
+
+#ifdef FRACTION_HAS_AVX2
+  if constexpr (std::is_same<D, double>::value && std::is_signed<T>::value &&
+                ((sizeof(T) == sizeof(std::int32_t)) || (sizeof(T) == sizeof(std::int64_t)))) {
+    typedef typename std::conditional<sizeof(T) == sizeof(std::int32_t), std::int32_t, std::int64_t>::type pair_type;
+    constexpr std::size_t lanes{4};
+
+    static_assert(sizeof(fraction<T, CHECK_T>) == (2 * sizeof(pair_type)), "Fractions need to be stored as pairs");
+
+    for (; (done + lanes) <= count; done += lanes) {
+      if (details::toDoubleBlockAvx2(reinterpret_cast<const pair_type*>(values + done), out + done)) continue;
+
+      for (std::size_t lane = 0; lane < lanes; ++lane)
+        out[done + lane] = static_cast<D>(values[done + lane]);
+    }
+  }
+#endif
+
+  for (std::size_t i = done; i < count; ++i)
+    out[i] = static_cast<D>(values[i]);
+}
+
+template <class D, class T, class CHECK_T, class CHECK_D>
+inline void fromFloatingPointBatch(const D* values, fraction<T, CHECK_T>* out, std::size_t count,
+                                   const D& precison) {
+  std::size_t done{0};
+
+#ifdef FRACTION_HAS_AVX2
+  if constexpr (std::is_same<D, double>::value && (sizeof(T) == sizeof(std::int32_t))) {
+    constexpr std::size_t lanes{4};
+
+    double numerators[lanes]{};
+    double denominators[lanes]{};
+
+    for (; (done + lanes) <= count; done += lanes) {
+      const int fallback{details::fromDoubleBlockAvx2(values + done, precison,
+                                                      static_cast<double>(std::numeric_limits<T>::max()),
+                                                      std::is_signed<T>::value, numerators, denominators)};
+
+      for (std::size_t lane = 0; lane < lanes; ++lane) {
+        if ((fallback & (1 << lane)) != 0)
+          out[done + lane] = fraction<T, CHECK_T>{values[done + lane], precison};
+        else
+          out[done + lane] = details::batch_access<T, CHECK_T>::makeReduced(static_cast<T>(numerators[lane]),
+                                                                            static_cast<T>(denominators[lane]));
+      }
+    }
+  }
+#endif
+
+  for (; done < count; ++done)
+    out[done] = fraction<T, CHECK_T>{values[done], precison};
+}
+
+template <class D, class T, class CHECK_T, class CHECK_D>
+inline void limitDenominatorBatch(const D* values, fraction<T, CHECK_T>* out, std::size_t count,
+                                  const T& maxDenominator) {
+  for (std::size_t i = 0; i < count; ++i)
+    out[i] = fraction<T, CHECK_T>::limitDenominator(values[i], maxDenominator);
+}
+
+template <class T, class CHECK_T>
+inline constexpr fraction<T, CHECK_T> fractionSum(const fraction<T, CHECK_T>* values, std::size_t count) {
+  details::wide_accumulator<T, CHECK_T> sum{};
+
+  for (std::size_t i = 0; i < count; ++i)
+    sum.add(values[i]);
+
+  return sum.result();
+}
+
+template <class T, class CHECK_T>
+inline constexpr fraction<T, CHECK_T> fractionDot(const fraction<T, CHECK_T>* lhs, const fraction<T, CHECK_T>* rhs,
+                                                  std::size_t count) {
+  details::wide_accumulator<T, CHECK_T> sum{};
+
+  for (std::size_t i = 0; i < count; ++i)
+    sum.addProduct(lhs[i], rhs[i]);
+
+  return sum.result();
+}
+
+template <class T, class CHECK_T>
+inline fraction<T, CHECK_T> fractionSum(const fraction<T, CHECK_T>* values, std::size_t count, unsigned int threads) {
+  return details::treeReduce<fraction<T, CHECK_T>>(
+      0, count, details::threadCount(threads),
+      [values](std::size_t begin, std::size_t leafCount) { return fractionSum(values + begin, leafCount); },
+      [](const fraction<T, CHECK_T>& lhs, const fraction<T, CHECK_T>& rhs) { return lhs + rhs; });
+}
+
+template <class T, class CHECK_T>
+inline constexpr fraction<T, CHECK_T> fractionProduct(const fraction<T, CHECK_T>* values, std::size_t count) {
+  fraction<T, CHECK_T> product{T{1}};
+
+  for (std::size_t i = 0; i < count; ++i)
+    product *= values[i];
+
+  return product;
+}
+
+template <class T, class CHECK_T>
+inline fraction<T, CHECK_T> fractionProduct(const fraction<T, CHECK_T>* values, std::size_t count,
+                                            unsigned int threads) {
+  return details::treeReduce<fraction<T, CHECK_T>>(
+      0, count, details::threadCount(threads),
+      [values](std::size_t begin, std::size_t leafCount) { return fractionProduct(values + begin, leafCount); },
+      [](const fraction<T, CHECK_T>& lhs, const fraction<T, CHECK_T>& rhs) { return lhs * rhs; });
+}
+
+template <class T, class CHECK_T>
+inline constexpr void fractionAxpy(const fraction<T, CHECK_T>& factor, const fraction<T, CHECK_T>* x,
+                                   fraction<T, CHECK_T>* y, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    details::wide_accumulator<T, CHECK_T> sum{};
+
+    sum.addProduct(factor, x[i]);
+    sum.add(y[i]);
+
+    y[i] = sum.result();
+  }
+}
+
+#endif  // !FRACTION_FRACTION_BATCH_HPP_
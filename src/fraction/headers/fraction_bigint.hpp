@@ -0,0 +1,1069 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#pragma once
+#ifndef FRACTION_FRACTION_BIGINT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "fraction.hpp"
+
+////////////////////////////////////////////////////////////
+// Declarations
+////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Signed integer of arbitrary size
+ *
+ * Stored as sign and magnitude, in 32 bit limbs. Values up to 128 bits are stored inline, so only larger values
+ * allocate. Division truncates towards 0, like it does for the built in types.
+ *
+ * Meant as the numerator and denominator type of @c fraction, for the cases where even 64 bits overflow.
+ */
+class bigint {
+ public:
+  typedef std::uint32_t limb_type;
+
+ private:
+  // Constants
+  typedef std::uint64_t double_limb_type;
+
+  static constexpr std::uint32_t INLINE_LIMBS{4};
+  static constexpr unsigned LIMB_BITS{32};
+  static constexpr double_limb_type LIMB_BASE{double_limb_type{1} << LIMB_BITS};
+
+  // Fields
+  union {
+    limb_type inlineLimbs[INLINE_LIMBS];
+    limb_type* heapLimbs;
+  };
+  /// Number of limbs in use. The highest one is never 0, so 0 has none
+  std::uint32_t size;
+  std::uint32_t capacity;
+  bool negative;
+
+ public:
+  bigint() noexcept;
+  template <class T, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+  bigint(T value);
+  /*!
+   * @brief Parses a decimal number with an optional leading minus
+   *
+   * @throws std::invalid_argument when @p digits isn't a decimal number.
+   */
+  explicit bigint(const std::string& digits);
+
+  bigint(const bigint& copy);
+  bigint(bigint&& move) noexcept;
+  ~bigint();
+
+  bigint& operator=(const bigint& rhs);
+  bigint& operator=(bigint&& rhs) noexcept;
+
+  bool isZero() const noexcept;
+  bool isNegative() const noexcept;
+  /// Number of bits of the magnitude
+  std::size_t bitWidth() const noexcept;
+  /// Whether the value is stored in a heap allocation
+  bool isAllocated() const noexcept;
+
+  /// Whether the value fits into the integer type @p T
+  template <class T, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+  bool fits() const noexcept;
+
+  /// @throws std::overflow_error when the value doesn't fit into @p T.
+  template <class T, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+  explicit operator T() const;
+
+  std::string toString() const;
+
+  /*!
+   * @brief Quotient and remainder at once
+   *
+   * The quotient is truncated towards 0 and the remainder has the sign of @p lhs.
+   *
+   * @throws std::invalid_argument when @p rhs is 0.
+   */
+  static void divide(const bigint& lhs, const bigint& rhs, bigint& quotient, bigint& remainder);
+  /// Greatest common divisor of the magnitudes. Always positive, unless both are 0
+  static bigint gcd(const bigint& lhs, const bigint& rhs);
+
+  // Arithmetic operators
+  bigint& operator+=(const bigint& rhs);
+  bigint& operator-=(const bigint& rhs);
+  bigint& operator*=(const bigint& rhs);
+  /// @throws std::invalid_argument when @p rhs is 0.
+  bigint& operator/=(const bigint& rhs);
+  /// @throws std::invalid_argument when @p rhs is 0.
+  bigint& operator%=(const bigint& rhs);
+
+  friend bigint operator+(bigint lhs, const bigint& rhs) { return lhs += rhs; }
+  friend bigint operator-(bigint lhs, const bigint& rhs) { return lhs -= rhs; }
+  friend bigint operator*(const bigint& lhs, const bigint& rhs) { return multiply(lhs, rhs); }
+  friend bigint operator/(const bigint& lhs, const bigint& rhs) {
+    bigint quotient;
+    bigint remainder;
+
+    divide(lhs, rhs, quotient, remainder);
+
+    return quotient;
+  }
+  friend bigint operator%(const bigint& lhs, const bigint& rhs) {
+    bigint quotient;
+    bigint remainder;
+
+    divide(lhs, rhs, quotient, remainder);
+
+    return remainder;
+  }
+
+  friend bigint operator+(const bigint& rhs) { return rhs; }
+  friend bigint operator-(bigint rhs) {
+    rhs.negative = !rhs.negative && (rhs.size != 0);
+
+    return rhs;
+  }
+
+  // Relational operators
+  friend bool operator==(const bigint& lhs, const bigint& rhs) noexcept { return compare(lhs, rhs) == 0; }
+  friend bool operator!=(const bigint& lhs, const bigint& rhs) noexcept { return compare(lhs, rhs) != 0; }
+  friend bool operator<(const bigint& lhs, const bigint& rhs) noexcept { return compare(lhs, rhs) < 0; }
+  friend bool operator>(const bigint& lhs, const bigint& rhs) noexcept { return compare(lhs, rhs) > 0; }
+  friend bool operator<=(const bigint& lhs, const bigint& rhs) noexcept { return compare(lhs, rhs) <= 0; }
+  friend bool operator>=(const bigint& lhs, const bigint& rhs) noexcept { return compare(lhs, rhs) >= 0; }
+
+  // Stream operators
+  template <class charT, class traits>
+  friend std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, traits>& ostream,
+                                                       const bigint& value) {
+    return ostream << value.toString().c_str();
+  }
+
+  friend struct std::hash<bigint>;
+
+ private:
+  limb_type* limbs() noexcept;
+  const limb_type* limbs() const noexcept;
+
+  /// Makes room for @p count limbs, keeping the current ones
+  void reserve(std::uint32_t count);
+  /// Drops leading zero limbs after an operation
+  void trim() noexcept;
+
+  static int compare(const bigint& lhs, const bigint& rhs) noexcept;
+  static int compareMagnitude(const bigint& lhs, const bigint& rhs) noexcept;
+
+  /// Adds the magnitude of @p rhs to the one of this, or subtracts it when @p subtract is set
+  void addMagnitude(const bigint& rhs, bool subtract);
+  static bigint multiply(const bigint& lhs, const bigint& rhs);
+  /// Multiplies the magnitude by @p factor and adds @p summand
+  void multiplyAdd(limb_type factor, limb_type summand);
+  /// Divides the magnitude by @p divisor and returns the remainder
+  limb_type divideSmall(limb_type divisor) noexcept;
+};
+
+template <>
+struct is_fraction_integer<bigint> : std::true_type {};
+
+/*!
+ * @brief Fraction of arbitrary size
+ *
+ * Numerator and denominator are @c bigint values, so the operations never overflow. Like all fractions it's always
+ * reduced, with a positive denominator.
+ *
+ * It supports the arithmetic, relational and stream output operators of @c fraction, with fraction and integer
+ * operands. Fractions of integer types convert into it implicitly, and @c toFraction converts back.
+ */
+template <>
+class fraction<bigint> {
+ public:
+  // Flags
+  static constexpr bool is_signed{true};
+  static constexpr bool is_unsigned{false};
+
+  typedef bigint value_type;
+
+ private:
+  /// Selects the constructor that takes a numerator and denominator that are already reduced
+  struct reduced_tag {};
+
+  // Fields
+  bigint numerator;
+  bigint denominator;
+
+ public:
+  /// @throws std::invalid_argument when @p denominator is 0.
+  fraction(const bigint& numerator = bigint{}, const bigint& denominator = bigint{1});
+
+  template <class T1, class CHECK_T1 = typename std::enable_if<std::is_integral<T1>::value>::type>
+  fraction(T1 numerator, T1 denominator = T1{1});
+
+  /// Widens a fraction of an integer type. Never fails
+  template <class T1, class CHECK_T1>
+  fraction(const fraction<T1, CHECK_T1>& value);
+
+ private:
+  fraction(bigint numerator, bigint denominator, reduced_tag) noexcept;
+
+ public:
+  const bigint& getNumerator() const noexcept;
+  const bigint& getDenominator() const noexcept;
+
+  /// @throws std::overflow_error when the numerator or denominator don't fit into @p T1.
+  template <class T1, class CHECK_T1 = typename std::enable_if<std::is_integral<T1>::value>::type>
+  fraction<T1, CHECK_T1> toFraction() const;
+
+  // Arithmetic operators
+  fraction<bigint>& operator+=(const fraction<bigint>& rhs);
+  fraction<bigint>& operator-=(const fraction<bigint>& rhs);
+  fraction<bigint>& operator*=(const fraction<bigint>& rhs);
+  /// @throws std::invalid_argument when @p rhs is 0.
+  fraction<bigint>& operator/=(const fraction<bigint>& rhs);
+
+  fraction<bigint>& operator++();
+  fraction<bigint> operator++(int);
+  fraction<bigint>& operator--();
+  fraction<bigint> operator--(int);
+
+  friend fraction<bigint> operator+(fraction<bigint> lhs, const fraction<bigint>& rhs) { return lhs += rhs; }
+  friend fraction<bigint> operator-(fraction<bigint> lhs, const fraction<bigint>& rhs) { return lhs -= rhs; }
+  friend fraction<bigint> operator*(fraction<bigint> lhs, const fraction<bigint>& rhs) { return lhs *= rhs; }
+  friend fraction<bigint> operator/(fraction<bigint> lhs, const fraction<bigint>& rhs) { return lhs /= rhs; }
+
+  // The templates take integer operands, which would pick the integer fraction operators otherwise
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend fraction<bigint> operator+(fraction<bigint> lhs, const D& rhs) {
+    return lhs += fraction<bigint>{rhs};
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend fraction<bigint> operator+(const D& lhs, fraction<bigint> rhs) {
+    return rhs += fraction<bigint>{lhs};
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend fraction<bigint> operator-(fraction<bigint> lhs, const D& rhs) {
+    return lhs -= fraction<bigint>{rhs};
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend fraction<bigint> operator-(const D& lhs, const fraction<bigint>& rhs) {
+    return fraction<bigint>{lhs} -= rhs;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend fraction<bigint> operator*(fraction<bigint> lhs, const D& rhs) {
+    return lhs *= fraction<bigint>{rhs};
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend fraction<bigint> operator*(const D& lhs, fraction<bigint> rhs) {
+    return rhs *= fraction<bigint>{lhs};
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend fraction<bigint> operator/(fraction<bigint> lhs, const D& rhs) {
+    return lhs /= fraction<bigint>{rhs};
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend fraction<bigint> operator/(const D& lhs, const fraction<bigint>& rhs) {
+    return fraction<bigint>{lhs} /= rhs;
+  }
+
+  friend fraction<bigint> operator+(const fraction<bigint>& rhs) { return rhs; }
+  friend fraction<bigint> operator-(const fraction<bigint>& rhs) {
+    return fraction<bigint>{-rhs.numerator, rhs.denominator, reduced_tag{}};
+  }
+
+  // Relational operators
+  friend bool operator==(const fraction<bigint>& lhs, const fraction<bigint>& rhs) noexcept {
+    return (lhs.numerator == rhs.numerator) && (lhs.denominator == rhs.denominator);
+  }
+  friend bool operator!=(const fraction<bigint>& lhs, const fraction<bigint>& rhs) noexcept { return !(lhs == rhs); }
+  friend bool operator<(const fraction<bigint>& lhs, const fraction<bigint>& rhs) { return compare(lhs, rhs) < 0; }
+  friend bool operator>(const fraction<bigint>& lhs, const fraction<bigint>& rhs) { return compare(lhs, rhs) > 0; }
+  friend bool operator<=(const fraction<bigint>& lhs, const fraction<bigint>& rhs) { return compare(lhs, rhs) <= 0; }
+  friend bool operator>=(const fraction<bigint>& lhs, const fraction<bigint>& rhs) { return compare(lhs, rhs) >= 0; }
+
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator==(const fraction<bigint>& lhs, const D& rhs) {
+    return compareInteger(lhs, rhs) == 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator==(const D& lhs, const fraction<bigint>& rhs) {
+    return compareInteger(rhs, lhs) == 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator!=(const fraction<bigint>& lhs, const D& rhs) {
+    return compareInteger(lhs, rhs) != 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator!=(const D& lhs, const fraction<bigint>& rhs) {
+    return compareInteger(rhs, lhs) != 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator<(const fraction<bigint>& lhs, const D& rhs) {
+    return compareInteger(lhs, rhs) < 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator<(const D& lhs, const fraction<bigint>& rhs) {
+    return compareInteger(rhs, lhs) > 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator>(const fraction<bigint>& lhs, const D& rhs) {
+    return compareInteger(lhs, rhs) > 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator>(const D& lhs, const fraction<bigint>& rhs) {
+    return compareInteger(rhs, lhs) < 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator<=(const fraction<bigint>& lhs, const D& rhs) {
+    return compareInteger(lhs, rhs) <= 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator<=(const D& lhs, const fraction<bigint>& rhs) {
+    return compareInteger(rhs, lhs) >= 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator>=(const fraction<bigint>& lhs, const D& rhs) {
+    return compareInteger(lhs, rhs) >= 0;
+  }
+  template <class D, class CHECK_D = typename std::enable_if<std::is_integral<D>::value>::type>
+  friend bool operator>=(const D& lhs, const fraction<bigint>& rhs) {
+    return compareInteger(rhs, lhs) <= 0;
+  }
+
+  // Stream operators
+  template <class charT, class traits>
+  friend std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, traits>& ostream,
+                                                       const fraction<bigint>& value) {
+    ostream << value.numerator << charT{'/'} << value.denominator;
+
+    return ostream;
+  }
+
+ private:
+  /// Divides out the gcd and moves the sign to the numerator
+  void reduce();
+
+  static int compare(const fraction<bigint>& lhs, const fraction<bigint>& rhs);
+  static int compareInteger(const fraction<bigint>& lhs, const bigint& value);
+
+  void add(const fraction<bigint>& rhs, bool subtract);
+};
+
+namespace std {
+template <>
+struct hash<bigint> {
+  size_t operator()(const bigint& value) const noexcept;
+};
+
+/// Hashes the reduced numerator and denominator, like for the other fractions
+template <>
+struct hash<fraction<bigint>> {
+  size_t operator()(const fraction<bigint>& value) const noexcept;
+};
+}  // namespace std
+
+////////////////////////////////////////////////////////////
+// Implementation
+////////////////////////////////////////////////////////////
+
+inline bigint::bigint() noexcept : inlineLimbs{}, size{0}, capacity{INLINE_LIMBS}, negative{false} {}
+
+template <class T, class CHECK_T>
+inline bigint::bigint(T value) : bigint{} {
+  typedef typename std::make_unsigned<T>::type unsigned_type;
+
+  static_assert(sizeof(unsigned_type) <= (INLINE_LIMBS * sizeof(limb_type)), "Integer types are stored inline");
+
+  unsigned_type magnitude{static_cast<unsigned_type>(value)};
+
+  if constexpr (std::is_signed<T>::value) {
+    if (value < T{0}) {
+      negative = true;
+      magnitude = static_cast<unsigned_type>(unsigned_type{0} - magnitude);
+    }
+  }
+
+  while (magnitude != unsigned_type{0}) {
+    inlineLimbs[size++] = static_cast<limb_type>(magnitude);
+
+    if constexpr (sizeof(unsigned_type) > sizeof(limb_type))
+      magnitude >>= LIMB_BITS;
+    else
+      magnitude = unsigned_type{0};
+  }
+}
+
+inline bigint::bigint(const std::string& digits) : bigint{} {
+  // Nine decimal digits always fit into a limb
+  constexpr limb_type CHUNK_POWERS[]{1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000,
+                                     1'000'000'000};
+
+  const bool minus{!digits.empty() && (digits.front() == '-')};
+  std::size_t position{minus ? std::size_t{1} : std::size_t{0}};
+
+  if (position == digits.size()) throw std::invalid_argument("The string is not a decimal number!");
+
+  while (position < digits.size()) {
+    limb_type chunk{0};
+    std::size_t length{0};
+
+    for (; (length < 9) && (position < digits.size()); ++length, ++position) {
+      const char digit{digits[position]};
+
+      if ((digit < '0') || (digit > '9')) throw std::invalid_argument("The string is not a decimal number!");
+
+      chunk = (chunk * 10) + static_cast<limb_type>(digit - '0');
+    }
+
+    multiplyAdd(CHUNK_POWERS[length], chunk);
+  }
+
+  negative = minus && (size != 0);
+}
+
+inline bigint::bigint(const bigint& copy) : bigint{} { *this = copy; }
+
+inline bigint::bigint(bigint&& move) noexcept : bigint{} { *this = std::move(move); }
+
+inline bigint::~bigint() {
+  if (isAllocated()) delete[] heapLimbs;
+}
+
+inline bigint& bigint::operator=(const bigint& rhs) {
+  if (this != &rhs) {
+    reserve(rhs.size);
+
+    if (rhs.size != 0) std::memcpy(limbs(), rhs.limbs(), rhs.size * sizeof(limb_type));
+
+    size = rhs.size;
+    negative = rhs.negative;
+  }
+
+  return *this;
+}
+
+inline bigint& bigint::operator=(bigint&& rhs) noexcept {
+  if (this != &rhs) {
+    if (isAllocated()) delete[] heapLimbs;
+
+    // Inline limbs get copied along with the union, heap limbs get taken over
+    std::memcpy(inlineLimbs, rhs.inlineLimbs, sizeof(inlineLimbs));
+    size = rhs.size;
+    capacity = rhs.capacity;
+    negative = rhs.negative;
+
+    rhs.capacity = INLINE_LIMBS;
+    rhs.size = 0;
+    rhs.negative = false;
+  }
+
+  return *this;
+}
+
+inline bool bigint::isZero() const noexcept { return size == 0; }
+
+inline bool bigint::isNegative() const noexcept { return negative; }
+
+inline std::size_t bigint::bitWidth() const noexcept {
+  if (size == 0) return 0;
+
+  return ((size - 1) * std::size_t{LIMB_BITS}) + static_cast<std::size_t>(details::bitWidth(limbs()[size - 1]));
+}
+
+inline bool bigint::isAllocated() const noexcept { return capacity > INLINE_LIMBS; }
+
+template <class T, class CHECK_T>
+inline bool bigint::fits() const noexcept {
+  constexpr std::size_t DIGITS{static_cast<std::size_t>(std::numeric_limits<T>::digits)};
+
+  if (negative && std::is_unsigned<T>::value) return false;
+  if (bitWidth() <= DIGITS) return true;
+  if (!negative || (bitWidth() != (DIGITS + 1))) return false;
+
+  // The minimum of a signed type is the only value with one bit more
+  for (std::uint32_t i = 0; i + 1 < size; ++i) {
+    if (limbs()[i] != 0) return false;
+  }
+
+  return (limbs()[size - 1] & (limbs()[size - 1] - 1)) == 0;
+}
+
+template <class T, class CHECK_T>
+inline bigint::operator T() const {
+  typedef typename std::make_unsigned<T>::type unsigned_type;
+
+  if (!fits<T>()) throw std::overflow_error("The bigint does not fit into the integer type!");
+
+  unsigned_type magnitude{0};
+
+  for (std::uint32_t i = size; i > 0; --i) {
+    if constexpr (sizeof(unsigned_type) > sizeof(limb_type)) magnitude <<= LIMB_BITS;
+
+    magnitude |= static_cast<unsigned_type>(limbs()[i - 1]);
+  }
+
+  return static_cast<T>(negative ? static_cast<unsigned_type>(unsigned_type{0} - magnitude) : magnitude);
+}
+
+inline std::string bigint::toString() const {
+  if (size == 0) return "0";
+
+  // Splitting off nine digits at a time needs a single division per limb
+  bigint magnitude{*this};
+  std::string digits;
+
+  while (magnitude.size != 0) {
+    limb_type chunk{magnitude.divideSmall(1'000'000'000)};
+
+    for (int i = 0; i < 9; ++i) {
+      digits.push_back(static_cast<char>('0' + (chunk % 10)));
+      chunk /= 10;
+
+      if ((magnitude.size == 0) && (chunk == 0)) break;
+    }
+  }
+
+  if (negative) digits.push_back('-');
+
+  return std::string{digits.rbegin(), digits.rend()};
+}
+
+inline void bigint::divide(const bigint& lhs, const bigint& rhs, bigint& quotient, bigint& remainder) {
+  if (rhs.size == 0) throw std::invalid_argument("The divisor must not be 0!");
+
+  const bool quotientNegative{lhs.negative != rhs.negative};
+  const bool remainderNegative{lhs.negative};
+
+  if (compareMagnitude(lhs, rhs) < 0) {
+    remainder = lhs;
+    quotient = bigint{};
+
+    return;
+  }
+
+  if (rhs.size == 1) {
+    bigint result{lhs};
+    const limb_type rest{result.divideSmall(rhs.limbs()[0])};
+
+    result.negative = quotientNegative && (result.size != 0);
+    remainder = bigint{rest};
+    remainder.negative = remainderNegative && (rest != 0);
+    quotient = std::move(result);
+
+    return;
+  }
+
+  // Knuth's algorithm D, as in Hacker's Delight. Normalizing makes the top limb of the divisor at least half the base,
+  // so each estimated quotient limb is off by at most 2
+  const std::uint32_t m{lhs.size};
+  const std::uint32_t n{rhs.size};
+  const int shift{static_cast<int>(LIMB_BITS) - details::bitWidth(rhs.limbs()[n - 1])};
+  const limb_type* const u{lhs.limbs()};
+  const limb_type* const v{rhs.limbs()};
+
+  bigint normalizedDivisor;
+  bigint normalizedDividend;
+  bigint result;
+
+  normalizedDivisor.reserve(n);
+  normalizedDividend.reserve(m + 1);
+  result.reserve(m - n + 1);
+
+  limb_type* const vn{normalizedDivisor.limbs()};
+  limb_type* const un{normalizedDividend.limbs()};
+  limb_type* const q{result.limbs()};
+
+  for (std::uint32_t i = n - 1; i > 0; --i)
+    vn[i] = (v[i] << shift) | static_cast<limb_type>((static_cast<double_limb_type>(v[i - 1]) >> (LIMB_BITS - shift)));
+  vn[0] = v[0] << shift;
+
+  un[m] = static_cast<limb_type>(static_cast<double_limb_type>(u[m - 1]) >> (LIMB_BITS - shift));
+  for (std::uint32_t i = m - 1; i > 0; --i)
+    un[i] = (u[i] << shift) | static_cast<limb_type>((static_cast<double_limb_type>(u[i - 1]) >> (LIMB_BITS - shift)));
+  un[0] = u[0] << shift;
+
+  for (std::uint32_t j = m - n + 1; j-- > 0;) {
+    const double_limb_type dividend{(static_cast<double_limb_type>(un[j + n]) << LIMB_BITS) | un[j + n - 1]};
+    double_limb_type estimate{dividend / vn[n - 1]};
+    double_limb_type rest{dividend % vn[n - 1]};
+
+    while ((estimate >= LIMB_BASE) || ((estimate * vn[n - 2]) > ((rest << LIMB_BITS) | un[j + n - 2]))) {
+      --estimate;
+      rest += vn[n - 1];
+
+      if (rest >= LIMB_BASE) break;
+    }
+
+    // Multiply and subtract
+    std::int64_t borrow{0};
+    std::int64_t difference{0};
+
+    for (std::uint32_t i = 0; i < n; ++i) {
+      const double_limb_type product{estimate * vn[i]};
+
+      difference = static_cast<std::int64_t>(un[i + j]) - borrow - static_cast<std::int64_t>(product & 0xFFFFFFFFU);
+      un[i + j] = static_cast<limb_type>(difference);
+      borrow = static_cast<std::int64_t>(product >> LIMB_BITS) - (difference >> LIMB_BITS);
+    }
+
+    difference = static_cast<std::int64_t>(un[j + n]) - borrow;
+    un[j + n] = static_cast<limb_type>(difference);
+    q[j] = static_cast<limb_type>(estimate);
+
+    // The estimate was one too large. Add the divisor back
+    if (difference < 0) {
+      double_limb_type carry{0};
+
+      --q[j];
+
+      for (std::uint32_t i = 0; i < n; ++i) {
+        const double_limb_type sum{static_cast<double_limb_type>(un[i + j]) + vn[i] + carry};
+
+        un[i + j] = static_cast<limb_type>(sum);
+        carry = sum >> LIMB_BITS;
+      }
+
+      un[j + n] = static_cast<limb_type>(un[j + n] + carry);
+    }
+  }
+
+  result.size = m - n + 1;
+  result.trim();
+  result.negative = quotientNegative && (result.size != 0);
+
+  // Undo the normalization of the remainder
+  for (std::uint32_t i = 0; i < n - 1; ++i) {
+    un[i] = static_cast<limb_type>((un[i] >> shift) |
+                                   (static_cast<double_limb_type>(un[i + 1]) << (LIMB_BITS - shift)));
+  }
+  un[n - 1] >>= shift;
+
+  normalizedDividend.size = n;
+  normalizedDividend.trim();
+  normalizedDividend.negative = remainderNegative && (normalizedDividend.size != 0);
+
+  quotient = std::move(result);
+  remainder = std::move(normalizedDividend);
+}
+
+inline bigint bigint::gcd(const bigint& lhs, const bigint& rhs) {
+  // Values that fit into 64 bits use the much faster integer gcd
+  if ((lhs.size <= 2) && (rhs.size <= 2)) {
+    const auto magnitude = [](const bigint& value) {
+      return (value.size == 0)   ? std::uint64_t{0}
+             : (value.size == 1) ? std::uint64_t{value.limbs()[0]}
+                                 : ((std::uint64_t{value.limbs()[1]} << LIMB_BITS) | value.limbs()[0]);
+    };
+
+    return bigint{details::gcd(magnitude(lhs), magnitude(rhs))};
+  }
+
+  bigint a{lhs};
+  bigint b{rhs};
+  bigint quotient;
+  bigint remainder;
+
+  a.negative = false;
+  b.negative = false;
+
+  while (b.size != 0) {
+    if ((a.size <= 2) && (b.size <= 2)) return gcd(a, b);
+
+    divide(a, b, quotient, remainder);
+    a = std::move(b);
+    b = std::move(remainder);
+  }
+
+  return a;
+}
+
+inline bigint& bigint::operator+=(const bigint& rhs) {
+  addMagnitude(rhs, negative != rhs.negative);
+
+  return *this;
+}
+
+inline bigint& bigint::operator-=(const bigint& rhs) {
+  addMagnitude(rhs, negative == rhs.negative);
+
+  return *this;
+}
+
+inline bigint& bigint::operator*=(const bigint& rhs) { return *this = multiply(*this, rhs); }
+
+inline bigint& bigint::operator/=(const bigint& rhs) {
+  bigint remainder;
+
+  divide(*this, rhs, *this, remainder);
+
+  return *this;
+}
+
+inline bigint& bigint::operator%=(const bigint& rhs) {
+  bigint quotient;
+
+  divide(*this, rhs, quotient, *this);
+
+  return *this;
+}
+
+inline bigint::limb_type* bigint::limbs() noexcept { return isAllocated() ? heapLimbs : inlineLimbs; }
+
+inline const bigint::limb_type* bigint::limbs() const noexcept { return isAllocated() ? heapLimbs : inlineLimbs; }
+
+inline void bigint::reserve(std::uint32_t count) {
+  if (count <= capacity) return;
+
+  // Growing geometrically keeps repeated growth linear
+  const std::uint32_t newCapacity{(count > (2 * capacity)) ? count : (2 * capacity)};
+  limb_type* const newLimbs{new limb_type[newCapacity]{}};
+
+  if (size != 0) std::memcpy(newLimbs, limbs(), size * sizeof(limb_type));
+  if (isAllocated()) delete[] heapLimbs;
+
+  heapLimbs = newLimbs;
+  capacity = newCapacity;
+}
+
+inline void bigint::trim() noexcept {
+  const limb_type* const data{limbs()};
+
+  while ((size != 0) && (data[size - 1] == 0)) --size;
+
+  if (size == 0) negative = false;
+}
+
+inline int bigint::compare(const bigint& lhs, const bigint& rhs) noexcept {
+  if (lhs.negative != rhs.negative) return lhs.negative ? -1 : 1;
+
+  const int magnitude{compareMagnitude(lhs, rhs)};
+
+  return lhs.negative ? -magnitude : magnitude;
+}
+
+inline int bigint::compareMagnitude(const bigint& lhs, const bigint& rhs) noexcept {
+  if (lhs.size != rhs.size) return (lhs.size < rhs.size) ? -1 : 1;
+
+  const limb_type* const lhsLimbs{lhs.limbs()};
+  const limb_type* const rhsLimbs{rhs.limbs()};
+
+  for (std::uint32_t i = lhs.size; i > 0; --i) {
+    if (lhsLimbs[i - 1] != rhsLimbs[i - 1]) return (lhsLimbs[i - 1] < rhsLimbs[i - 1]) ? -1 : 1;
+  }
+
+  return 0;
+}
+
+inline void bigint::addMagnitude(const bigint& rhs, bool subtract) {
+  if (&rhs == this) {
+    const bigint copy{rhs};
+
+    addMagnitude(copy, subtract);
+
+    return;
+  }
+
+  if (!subtract) {
+    const std::uint32_t count{(size > rhs.size) ? size : rhs.size};
+
+    reserve(count + 1);
+
+    limb_type* const data{limbs()};
+    const limb_type* const rhsLimbs{rhs.limbs()};
+    double_limb_type carry{0};
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+      const double_limb_type sum{static_cast<double_limb_type>((i < size) ? data[i] : 0) +
+                                 ((i < rhs.size) ? rhsLimbs[i] : 0) + carry};
+
+      data[i] = static_cast<limb_type>(sum);
+      carry = sum >> LIMB_BITS;
+    }
+
+    data[count] = static_cast<limb_type>(carry);
+    size = count + 1;
+    trim();
+
+    return;
+  }
+
+  // Subtract the smaller magnitude from the larger one. The sign flips when rhs is larger
+  const int order{compareMagnitude(*this, rhs)};
+
+  if (order == 0) {
+    size = 0;
+    negative = false;
+
+    return;
+  }
+
+  const bool flip{order < 0};
+  const std::uint32_t count{flip ? rhs.size : size};
+
+  reserve(count);
+
+  limb_type* const data{limbs()};
+  const limb_type* const rhsLimbs{rhs.limbs()};
+  std::int64_t borrow{0};
+
+  for (std::uint32_t i = 0; i < count; ++i) {
+    const std::int64_t own{static_cast<std::int64_t>((i < size) ? data[i] : 0)};
+    const std::int64_t other{static_cast<std::int64_t>((i < rhs.size) ? rhsLimbs[i] : 0)};
+    std::int64_t difference{(flip ? (other - own) : (own - other)) - borrow};
+
+    borrow = (difference < 0) ? 1 : 0;
+    difference += borrow * static_cast<std::int64_t>(LIMB_BASE);
+    data[i] = static_cast<limb_type>(difference);
+  }
+
+  size = count;
+  negative = flip ? !negative : negative;
+  trim();
+}
+
+inline bigint bigint::multiply(const bigint& lhs, const bigint& rhs) {
+  bigint result;
+
+  if ((lhs.size == 0) || (rhs.size == 0)) return result;
+
+  result.reserve(lhs.size + rhs.size);
+
+  limb_type* const data{result.limbs()};
+  const limb_type* const lhsLimbs{lhs.limbs()};
+  const limb_type* const rhsLimbs{rhs.limbs()};
+
+  for (std::uint32_t i = 0; i < lhs.size + rhs.size; ++i) data[i] = 0;
+
+  for (std::uint32_t i = 0; i < lhs.size; ++i) {
+    double_limb_type carry{0};
+
+    for (std::uint32_t j = 0; j < rhs.size; ++j) {
+      // Can't overflow: (2^32 - 1)^2 + 2 * (2^32 - 1) = 2^64 - 1
+      const double_limb_type product{(static_cast<double_limb_type>(lhsLimbs[i]) * rhsLimbs[j]) + data[i + j] + carry};
+
+      data[i + j] = static_cast<limb_type>(product);
+      carry = product >> LIMB_BITS;
+    }
+
+    data[i + rhs.size] = static_cast<limb_type>(carry);
+  }
+
+  result.size = lhs.size + rhs.size;
+  result.trim();
+  result.negative = (lhs.negative != rhs.negative) && (result.size != 0);
+
+  return result;
+}
+
+inline void bigint::multiplyAdd(limb_type factor, limb_type summand) {
+  reserve(size + 1);
+
+  limb_type* const data{limbs()};
+  double_limb_type carry{summand};
+
+  for (std::uint32_t i = 0; i < size; ++i) {
+    const double_limb_type product{(static_cast<double_limb_type>(data[i]) * factor) + carry};
+
+    data[i] = static_cast<limb_type>(product);
+    carry = product >> LIMB_BITS;
+  }
+
+  data[size++] = static_cast<limb_type>(carry);
+  trim();
+}
+
+inline bigint::limb_type bigint::divideSmall(limb_type divisor) noexcept {
+  limb_type* const data{limbs()};
+  double_limb_type rest{0};
+
+  for (std::uint32_t i = size; i > 0; --i) {
+    const double_limb_type dividend{(rest << LIMB_BITS) | data[i - 1]};
+
+    data[i - 1] = static_cast<limb_type>(dividend / divisor);
+    rest = dividend % divisor;
+  }
+
+  trim();
+
+  return static_cast<limb_type>(rest);
+}
+
+inline fraction<bigint>::fraction(const bigint& numerator, const bigint& denominator)
+    : numerator{numerator}, denominator{denominator} {
+  if (denominator.isZero()) throw std::invalid_argument("The denominator must not be 0!");
+
+  reduce();
+}
+
+template <class T1, class CHECK_T1>
+inline fraction<bigint>::fraction(T1 numerator, T1 denominator) : fraction{bigint{numerator}, bigint{denominator}} {}
+
+template <class T1, class CHECK_T1>
+inline fraction<bigint>::fraction(const fraction<T1, CHECK_T1>& value)
+    : numerator{value.getNumerator()}, denominator{value.getDenominator()} {}
+
+inline fraction<bigint>::fraction(bigint numerator, bigint denominator, reduced_tag) noexcept
+    : numerator{std::move(numerator)}, denominator{std::move(denominator)} {}
+
+inline const bigint& fraction<bigint>::getNumerator() const noexcept { return numerator; }
+
+inline const bigint& fraction<bigint>::getDenominator() const noexcept { return denominator; }
+
+template <class T1, class CHECK_T1>
+inline fraction<T1, CHECK_T1> fraction<bigint>::toFraction() const {
+  if (!numerator.fits<T1>() || !denominator.fits<T1>())
+    throw std::overflow_error("The result does not fit into the fraction!");
+
+  return fraction<T1, CHECK_T1>{static_cast<T1>(numerator), static_cast<T1>(denominator)};
+}
+
+inline fraction<bigint>& fraction<bigint>::operator+=(const fraction<bigint>& rhs) {
+  add(rhs, false);
+
+  return *this;
+}
+
+inline fraction<bigint>& fraction<bigint>::operator-=(const fraction<bigint>& rhs) {
+  add(rhs, true);
+
+  return *this;
+}
+
+inline fraction<bigint>& fraction<bigint>::operator*=(const fraction<bigint>& rhs) {
+  // Both are reduced, so only the gcds across need to be cancelled, and those are of smaller numbers
+  if (numerator.isZero() || rhs.numerator.isZero()) return *this = fraction<bigint>{};
+
+  const bigint gcd1{bigint::gcd(numerator, rhs.denominator)};
+  const bigint gcd2{bigint::gcd(rhs.numerator, denominator)};
+
+  numerator = (numerator / gcd1) * (rhs.numerator / gcd2);
+  denominator = (denominator / gcd2) * (rhs.denominator / gcd1);
+
+  return *this;
+}
+
+inline fraction<bigint>& fraction<bigint>::operator/=(const fraction<bigint>& rhs) {
+  if (rhs.numerator.isZero()) throw std::invalid_argument("The denominator must not be 0!");
+
+  // Multiplying with the reciprocal. Its sign moves back to the numerator
+  fraction<bigint> reciprocal{rhs.denominator, rhs.numerator, reduced_tag{}};
+
+  if (reciprocal.denominator.isNegative()) {
+    reciprocal.numerator = -reciprocal.numerator;
+    reciprocal.denominator = -reciprocal.denominator;
+  }
+
+  return *this *= reciprocal;
+}
+
+inline fraction<bigint>& fraction<bigint>::operator++() {
+  // gcd(n + d, d) = gcd(n, d) = 1, so the result stays reduced
+  numerator += denominator;
+
+  return *this;
+}
+
+inline fraction<bigint> fraction<bigint>::operator++(int) {
+  fraction<bigint> copy{*this};
+
+  operator++();
+
+  return copy;
+}
+
+inline fraction<bigint>& fraction<bigint>::operator--() {
+  numerator -= denominator;
+
+  return *this;
+}
+
+inline fraction<bigint> fraction<bigint>::operator--(int) {
+  fraction<bigint> copy{*this};
+
+  operator--();
+
+  return copy;
+}
+
+inline void fraction<bigint>::reduce() {
+  const bigint gcd{bigint::gcd(numerator, denominator)};
+
+  if (gcd != bigint{1}) {
+    numerator /= gcd;
+    denominator /= gcd;
+  }
+
+  if (denominator.isNegative()) {
+    numerator = -numerator;
+    denominator = -denominator;
+  }
+}
+
+inline int fraction<bigint>::compare(const fraction<bigint>& lhs, const fraction<bigint>& rhs) {
+  // The denominators are positive, so cross multiplying keeps the order
+  if (lhs.denominator == rhs.denominator)
+    return (lhs.numerator < rhs.numerator) ? -1 : ((lhs.numerator > rhs.numerator) ? 1 : 0);
+
+  const bigint lhsProduct{lhs.numerator * rhs.denominator};
+  const bigint rhsProduct{rhs.numerator * lhs.denominator};
+
+  return (lhsProduct < rhsProduct) ? -1 : ((lhsProduct > rhsProduct) ? 1 : 0);
+}
+
+inline int fraction<bigint>::compareInteger(const fraction<bigint>& lhs, const bigint& value) {
+  const bigint product{value * lhs.denominator};
+
+  return (lhs.numerator < product) ? -1 : ((lhs.numerator > product) ? 1 : 0);
+}
+
+inline void fraction<bigint>::add(const fraction<bigint>& rhs, bool subtract) {
+  // Knuth's algorithm: only the gcd of the denominators and the one of the result with it need to be cancelled
+  const bigint gcd{bigint::gcd(denominator, rhs.denominator)};
+  const bigint rhsNumerator{subtract ? -rhs.numerator : rhs.numerator};
+
+  if (gcd == bigint{1}) {
+    numerator = (numerator * rhs.denominator) + (rhsNumerator * denominator);
+    denominator *= rhs.denominator;
+
+    return;
+  }
+
+  const bigint sum{(numerator * (rhs.denominator / gcd)) + (rhsNumerator * (denominator / gcd))};
+
+  if (sum.isZero()) {
+    *this = fraction<bigint>{};
+
+    return;
+  }
+
+  const bigint gcd2{bigint::gcd(sum, gcd)};
+
+  numerator = sum / gcd2;
+  denominator = (denominator / gcd) * (rhs.denominator / gcd2);
+}
+
+namespace std {
+inline size_t hash<bigint>::operator()(const bigint& value) const noexcept {
+  const bigint::limb_type* const limbs{value.limbs()};
+  std::uint64_t hash{value.negative ? 0x9E3779B97F4A7C15ULL : 0};
+
+  for (std::uint32_t i = 0; i < value.size; ++i) hash = details::mixHash(hash ^ limbs[i]);
+
+  return static_cast<size_t>(hash);
+}
+
+inline size_t hash<fraction<bigint>>::operator()(const fraction<bigint>& value) const noexcept {
+  return static_cast<size_t>(details::mixHash((hash<bigint>{}(value.getNumerator()) * 0x9E3779B97F4A7C15ULL) ^
+                                              hash<bigint>{}(value.getDenominator())));
+}
+}  // namespace std
+
+#endif  // !FRACTION_FRACTION_BIGINT_HPP_
@@ -0,0 +1,344 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#pragma once
+#ifndef FRACTION_FRACTION_CODEC_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "fraction.hpp"
+#include "fraction_batch.hpp"
+
+////////////////////////////////////////////////////////////
+// Details
+////////////////////////////////////////////////////////////
+
+namespace details {
+/// Number of bytes a LEB128 encoding of @p BITS bits takes at most
+constexpr std::size_t varintMaxSize(int bits) noexcept { return static_cast<std::size_t>((bits + 6) / 7); }
+
+/// Writes @p value as unsigned LEB128: 7 bits per byte, least significant first, the high bit marks that more follow
+template <class U>
+constexpr unsigned char* writeVarint(U value, unsigned char* out) noexcept {
+  for (; value >= U{0x80}; value = static_cast<U>(value >> 7))
+    *out++ = static_cast<unsigned char>(static_cast<unsigned int>(value & U{0x7F}) | 0x80U);
+
+  *out++ = static_cast<unsigned char>(value);
+
+  return out;
+}
+
+/*!
+ * @brief Reads an unsigned LEB128 value and drops its lowest @p SKIP bits
+ *
+ * Dropping bits the caller has already taken from the first byte lets a value of @p BITS + @p SKIP bits be read into
+ * a type of just @p BITS bits.
+ *
+ * @throws std::invalid_argument when the data ends in the middle of the value.
+ * @throws std::overflow_error when the value has more than @p BITS bits after dropping.
+ */
+template <int BITS, int SKIP = 0, class U>
+constexpr const unsigned char* readVarint(const unsigned char* first, const unsigned char* last, U& value) {
+  static_assert(BITS <= std::numeric_limits<U>::digits, "The value has to fit into U");
+
+  // Most values of real data are small, so a single byte gets its own path
+  if ((first != last) && (*first < 0x80U)) {
+    value = static_cast<U>(*first >> SKIP);
+
+    return first + 1;
+  }
+
+  value = U{0};
+
+  for (int shift = -SKIP; first != last; shift += 7) {
+    const unsigned int byte{*first++};
+
+    // The last byte may only use the bits that are left
+    if (((shift + 7) > BITS) && ((shift >= BITS) || (((byte & 0x7FU) >> (BITS - shift)) != 0)))
+      throw std::overflow_error("The result does not fit into the fraction!");
+
+    const U bits{(shift < 0) ? static_cast<U>((byte & 0x7FU) >> -shift)
+                             : static_cast<U>(static_cast<U>(byte & 0x7FU) << shift)};
+
+    value = static_cast<U>(value | bits);
+
+    if ((byte & 0x80U) == 0) return first;
+  }
+
+  throw std::invalid_argument("The encoded data is truncated!");
+}
+
+/// Lookup table of the CRC-32 used by zlib and PNG (reflected polynomial 0xEDB88320)
+constexpr std::array<std::uint32_t, 256> makeCrc32Table() noexcept {
+  std::array<std::uint32_t, 256> table{};
+
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t crc{i};
+
+    for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ ((crc & 1U) != 0 ? 0xEDB88320U : 0U);
+
+    table[i] = crc;
+  }
+
+  return table;
+}
+
+inline constexpr std::array<std::uint32_t, 256> crc32Table{makeCrc32Table()};
+
+/// Continues the CRC-32 @p crc over @p size bytes. Start with 0
+constexpr std::uint32_t crc32(const unsigned char* data, std::size_t size, std::uint32_t crc = 0) noexcept {
+  crc = ~crc;
+
+  for (std::size_t i = 0; i < size; ++i) crc = crc32Table[(crc ^ data[i]) & 0xFFU] ^ (crc >> 8);
+
+  return ~crc;
+}
+}  // namespace details
+
+////////////////////////////////////////////////////////////
+// Declarations
+////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Binary codec for fractions
+ *
+ * Every fraction is stored as one or two LEB128 varints. The first holds the numerator (zigzag encoded for signed
+ * types, so small negative values stay short) shifted left by one. Its lowest bit is set when the denominator is 1, in
+ * which case no denominator follows. Otherwise the denominator follows as the second varint. So @c 1/2 takes two bytes
+ * and small integers a single one.
+ *
+ * Blocks frame a number of encoded fractions:
+ * - the number of fractions as varint
+ * - the size of the encoded fractions in bytes as varint
+ * - the encoded fractions
+ * - the CRC-32 of everything before, as 4 bytes little endian
+ *
+ * The encoders only write reduced fractions, and the decoders reject everything else. So they check the range, the
+ * denominator and that numerator and denominator are coprime, which costs one gcd per fraction with a denominator.
+ * Blocks also protect against accidental corruption with their checksum.\n
+ * The codec doesn't depend on the byte order of the platform.
+ *
+ * @tparam T       Integer type of numerator and denominator
+ * @tparam CHECK_T Used for checking if @p T is an integer type
+ */
+template <class T, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+struct fraction_codec {
+  typedef fraction<T, CHECK_T> fraction_type;
+
+ private:
+  typedef typename std::make_unsigned<T>::type unsigned_type;
+  typedef details::wide_t<unsigned_type> wide_type;
+
+  static constexpr int DIGITS{std::numeric_limits<unsigned_type>::digits};
+
+  static constexpr std::size_t BLOCK_HEADER_SIZE{2 * details::varintMaxSize(std::numeric_limits<std::size_t>::digits)};
+  static constexpr std::size_t CHECKSUM_SIZE{4};
+
+ public:
+  /// Most bytes a single encoded fraction takes
+  static constexpr std::size_t maxEncodedSize{details::varintMaxSize(DIGITS + 1) + details::varintMaxSize(DIGITS)};
+
+  /// Most bytes a block of @p count fractions takes
+  static constexpr std::size_t maxBlockSize(std::size_t count) noexcept;
+
+  /// Encodes a single fraction. @p out needs room for @c maxEncodedSize bytes. Returns the end of the written bytes
+  static constexpr unsigned char* encode(const fraction_type& value, unsigned char* out) noexcept;
+
+  /*!
+   * @brief Decodes a single fraction
+   *
+   * @returns The end of the read bytes
+   * @throws std::invalid_argument when the data is truncated or malformed, or the fraction isn't reduced.
+   * @throws std::overflow_error when the value doesn't fit into @p T (like when it was written with a larger type).
+   */
+  static constexpr const unsigned char* decode(const unsigned char* first, const unsigned char* last,
+                                               fraction_type& value);
+
+  /// Encodes @p count fractions back to back. @p out needs room for @p count times @c maxEncodedSize bytes
+  static constexpr unsigned char* encode(const fraction_type* values, std::size_t count, unsigned char* out) noexcept;
+
+  /// Decodes @p count fractions written back to back. Throws like the single value @c decode
+  static constexpr const unsigned char* decode(const unsigned char* first, const unsigned char* last,
+                                               fraction_type* values, std::size_t count);
+
+  /// Encodes @p count fractions as a block. @p out needs room for @c maxBlockSize(count) bytes
+  static constexpr unsigned char* encodeBlock(const fraction_type* values, std::size_t count,
+                                              unsigned char* out) noexcept;
+
+  /*!
+   * @brief Decodes a block and appends its fractions to @p values
+   *
+   * @returns The end of the block
+   * @throws std::invalid_argument when the data is truncated or malformed, a fraction isn't reduced, or the checksum
+   * doesn't match.
+   * @throws std::overflow_error when a value doesn't fit into @p T. Nothing is appended in either case.
+   */
+  static const unsigned char* decodeBlock(const unsigned char* first, const unsigned char* last,
+                                          std::vector<fraction_type>& values);
+};
+
+////////////////////////////////////////////////////////////
+// Implementation
+////////////////////////////////////////////////////////////
+
+template <class T, class CHECK_T>
+inline constexpr std::size_t fraction_codec<T, CHECK_T>::maxBlockSize(std::size_t count) noexcept {
+  return BLOCK_HEADER_SIZE + (count * maxEncodedSize) + CHECKSUM_SIZE;
+}
+
+template <class T, class CHECK_T>
+inline constexpr unsigned char* fraction_codec<T, CHECK_T>::encode(const fraction_type& value,
+                                                                   unsigned char* out) noexcept {
+  const T& numerator{value.getNumerator()};
+  const T& denominator{value.getDenominator()};
+  const unsigned_type integerFlag{(denominator == T{1}) ? unsigned_type{1} : unsigned_type{0}};
+
+  unsigned_type head{static_cast<unsigned_type>(numerator)};
+
+  // Zigzag: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+  if constexpr (std::is_signed<T>::value) {
+    head = static_cast<unsigned_type>(head << 1);
+
+    if (numerator < T{0}) head = static_cast<unsigned_type>(~head);
+  }
+
+  // The flag only fits next to the numerator when its top bit is free
+  if ((head >> (DIGITS - 1)) == unsigned_type{0})
+    out = details::writeVarint(static_cast<unsigned_type>((head << 1) | integerFlag), out);
+  else
+    out = details::writeVarint(static_cast<wide_type>((wide_type{head} << 1) | wide_type{integerFlag}), out);
+
+  if (integerFlag == unsigned_type{0}) out = details::writeVarint(static_cast<unsigned_type>(denominator), out);
+
+  return out;
+}
+
+template <class T, class CHECK_T>
+inline constexpr const unsigned char* fraction_codec<T, CHECK_T>::decode(const unsigned char* first,
+                                                                         const unsigned char* last,
+                                                                         fraction_type& value) {
+  constexpr unsigned_type MAX{static_cast<unsigned_type>(std::numeric_limits<T>::max())};
+
+  // The flag is the lowest bit of the first byte, so the numerator can be read without the double width
+  const bool integer{(first != last) && ((*first & 1U) != 0)};
+  unsigned_type head{};
+
+  first = details::readVarint<DIGITS, 1>(first, last, head);
+
+  T numerator{};
+
+  if constexpr (std::is_signed<T>::value) {
+    const unsigned_type magnitude{static_cast<unsigned_type>(head >> 1)};
+
+    numerator = ((head & unsigned_type{1}) == unsigned_type{0}) ? static_cast<T>(magnitude)
+                                                                  : static_cast<T>(~magnitude);
+  } else {
+    numerator = head;
+  }
+
+  unsigned_type denominator{1};
+
+  if (!integer) {
+    first = details::readVarint<DIGITS>(first, last, denominator);
+
+    // Reduced fractions have no other denominator than 1 with 0 as numerator
+    if ((denominator <= unsigned_type{1}) || (numerator == T{0}))
+      throw std::invalid_argument("The encoded data is corrupt!");
+    if (denominator > MAX) throw std::overflow_error("The result does not fit into the fraction!");
+    // The data may come from anywhere, so a single gcd makes sure it can't produce an unreduced fraction
+    if (details::gcd(details::magnitude(numerator), denominator) != unsigned_type{1})
+      throw std::invalid_argument("The encoded data is not reduced!");
+  }
+
+  value = details::batch_access<T, CHECK_T>::makeReduced(numerator, static_cast<T>(denominator));
+
+  return first;
+}
+
+template <class T, class CHECK_T>
+inline constexpr unsigned char* fraction_codec<T, CHECK_T>::encode(const fraction_type* values, std::size_t count,
+                                                                   unsigned char* out) noexcept {
+  for (std::size_t i = 0; i < count; ++i) out = encode(values[i], out);
+
+  return out;
+}
+
+template <class T, class CHECK_T>
+inline constexpr const unsigned char* fraction_codec<T, CHECK_T>::decode(const unsigned char* first,
+                                                                         const unsigned char* last,
+                                                                         fraction_type* values, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) first = decode(first, last, values[i]);
+
+  return first;
+}
+
+template <class T, class CHECK_T>
+inline constexpr unsigned char* fraction_codec<T, CHECK_T>::encodeBlock(const fraction_type* values,
+                                                                        std::size_t count,
+                                                                        unsigned char* out) noexcept {
+  // The size of the payload isn't known before encoding it, so it's encoded after the largest possible header first
+  unsigned char* const payload{out + BLOCK_HEADER_SIZE};
+  const unsigned char* const payloadEnd{encode(values, count, payload)};
+  const std::size_t payloadSize{static_cast<std::size_t>(payloadEnd - payload)};
+
+  unsigned char* position{details::writeVarint(count, out)};
+  position = details::writeVarint(payloadSize, position);
+
+  for (std::size_t i = 0; i < payloadSize; ++i) position[i] = payload[i];
+
+  position += payloadSize;
+
+  const std::uint32_t checksum{details::crc32(out, static_cast<std::size_t>(position - out))};
+
+  for (std::size_t i = 0; i < CHECKSUM_SIZE; ++i) *position++ = static_cast<unsigned char>(checksum >> (8 * i));
+
+  return position;
+}
+
+template <class T, class CHECK_T>
+inline const unsigned char* fraction_codec<T, CHECK_T>::decodeBlock(const unsigned char* first,
+                                                                    const unsigned char* last,
+                                                                    std::vector<fraction_type>& values) {
+  constexpr int SIZE_DIGITS{std::numeric_limits<std::size_t>::digits};
+
+  std::size_t count{};
+  std::size_t payloadSize{};
+  const unsigned char* position{details::readVarint<SIZE_DIGITS>(first, last, count)};
+  position = details::readVarint<SIZE_DIGITS>(position, last, payloadSize);
+
+  // Every fraction takes at least one byte
+  if ((count > payloadSize) || (static_cast<std::size_t>(last - position) < CHECKSUM_SIZE) ||
+      ((static_cast<std::size_t>(last - position) - CHECKSUM_SIZE) < payloadSize))
+    throw std::invalid_argument("The encoded data is truncated!");
+
+  const unsigned char* const payloadEnd{position + payloadSize};
+  std::uint32_t checksum{0};
+
+  for (std::size_t i = 0; i < CHECKSUM_SIZE; ++i) checksum |= static_cast<std::uint32_t>(payloadEnd[i]) << (8 * i);
+
+  if (details::crc32(first, static_cast<std::size_t>(payloadEnd - first)) != checksum)
+    throw std::invalid_argument("The checksum of the encoded data does not match!");
+
+  const std::size_t oldSize{values.size()};
+  values.resize(oldSize + count);
+
+  try {
+    if (decode(position, payloadEnd, values.data() + oldSize, count) != payloadEnd)
+      throw std::invalid_argument("The encoded data is corrupt!");
+  } catch (...) {
+    values.resize(oldSize);
+
+    throw;
+  }
+
+  return payloadEnd + CHECKSUM_SIZE;
+}
+
+#endif  // !FRACTION_FRACTION_CODEC_HPP_
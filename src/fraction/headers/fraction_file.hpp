@@ -0,0 +1,542 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#pragma once
+#ifndef FRACTION_FRACTION_FILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "fraction.hpp"
+#include "fraction_vector.hpp"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////
+// Details
+////////////////////////////////////////////////////////////
+
+namespace details {
+/*!
+ * @brief Header at the start of a fraction file
+ *
+ * All fields are in the byte order of the machine that wrote the file. @c byteOrder tells which one that was.
+ */
+struct fraction_file_header {
+  static constexpr char expectedMagic[8]{'F', 'R', 'A', 'C', 'C', 'O', 'L', '\0'};
+  static constexpr std::uint32_t currentVersion{1};
+  static constexpr std::uint32_t nativeByteOrder{0x01020304};
+
+  static constexpr std::uint32_t flagSigned{1U << 0};
+  static constexpr std::uint32_t flagAllReduced{1U << 1};
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  /// Size of the numerators and denominators in bytes
+  std::uint32_t valueSize;
+  std::uint32_t flags;
+  std::uint64_t count;
+  /// Number of fractions each summary covers
+  std::uint64_t blockSize;
+  std::uint64_t numeratorOffset;
+  std::uint64_t denominatorOffset;
+  /// Minimum and maximum of every block, as reduced numerator and denominator pairs
+  std::uint64_t summaryOffset;
+};
+
+static_assert(sizeof(fraction_file_header) == 64, "The header has to have the same size everywhere");
+
+/// Columns start on a cache line, like the ones of @c fraction_vector
+constexpr std::uint64_t fractionFileAlignment{64};
+
+constexpr std::uint64_t alignFileOffset(std::uint64_t offset) noexcept {
+  return (offset + fractionFileAlignment - 1) / fractionFileAlignment * fractionFileAlignment;
+}
+
+/// Read only memory mapping of a whole file
+class mapped_file {
+ private:
+  const unsigned char* data{nullptr};
+  std::size_t size{0};
+#if defined(_WIN32)
+  HANDLE file{INVALID_HANDLE_VALUE};
+  HANDLE mapping{nullptr};
+#endif
+
+ public:
+  /// @throws std::runtime_error when the file can't be opened or mapped.
+  explicit mapped_file(const std::string& path);
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file(mapped_file&& other) noexcept;
+  ~mapped_file();
+
+  mapped_file& operator=(const mapped_file&) = delete;
+  mapped_file& operator=(mapped_file&& other) noexcept;
+
+  const unsigned char* getData() const noexcept { return data; }
+  std::size_t getSize() const noexcept { return size; }
+
+ private:
+  void unmap() noexcept;
+};
+
+#if defined(_WIN32)
+inline mapped_file::mapped_file(const std::string& path) {
+  file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                     nullptr);
+
+  if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("The fraction file could not be opened!");
+
+  LARGE_INTEGER fileSize{};
+
+  if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart <= 0)) {
+    unmap();
+
+    throw std::runtime_error("The fraction file could not be mapped!");
+  }
+
+  size = static_cast<std::size_t>(fileSize.QuadPart);
+  mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (mapping != nullptr) data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+  if (data == nullptr) {
+    unmap();
+
+    throw std::runtime_error("The fraction file could not be mapped!");
+  }
+}
+
+inline void mapped_file::unmap() noexcept {
+  if (data != nullptr) UnmapViewOfFile(data);
+  if (mapping != nullptr) CloseHandle(mapping);
+  if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+
+  data = nullptr;
+  size = 0;
+  mapping = nullptr;
+  file = INVALID_HANDLE_VALUE;
+}
+#else
+inline mapped_file::mapped_file(const std::string& path) {
+  const int descriptor{::open(path.c_str(), O_RDONLY)};
+
+  if (descriptor < 0) throw std::runtime_error("The fraction file could not be opened!");
+
+  struct stat status {};
+
+  if ((::fstat(descriptor, &status) != 0) || (status.st_size <= 0)) {
+    ::close(descriptor);
+
+    throw std::runtime_error("The fraction file could not be mapped!");
+  }
+
+  size = static_cast<std::size_t>(status.st_size);
+  void* const mapping{::mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0)};
+
+  // The mapping stays valid without the descriptor
+  ::close(descriptor);
+
+  if (mapping == MAP_FAILED) {
+    size = 0;
+
+    throw std::runtime_error("The fraction file could not be mapped!");
+  }
+
+  data = static_cast<const unsigned char*>(mapping);
+}
+
+inline void mapped_file::unmap() noexcept {
+  if (data != nullptr) ::munmap(const_cast<unsigned char*>(data), size);
+
+  data = nullptr;
+  size = 0;
+}
+#endif
+
+inline mapped_file::mapped_file(mapped_file&& other) noexcept { *this = std::move(other); }
+
+inline mapped_file::~mapped_file() { unmap(); }
+
+inline mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+  if (this != &other) {
+    unmap();
+
+    data = other.data;
+    size = other.size;
+    other.data = nullptr;
+    other.size = 0;
+#if defined(_WIN32)
+    file = other.file;
+    mapping = other.mapping;
+    other.file = INVALID_HANDLE_VALUE;
+    other.mapping = nullptr;
+#endif
+  }
+
+  return *this;
+}
+}  // namespace details
+
+////////////////////////////////////////////////////////////
+// Declarations
+////////////////////////////////////////////////////////////
+
+/// Zero copy view of a column, like a @c std::span of constant elements
+template <class T>
+class fraction_column_view {
+ public:
+  typedef T value_type;
+  typedef std::size_t size_type;
+  typedef const T* iterator;
+
+ private:
+  const T* first{nullptr};
+  size_type count{0};
+
+ public:
+  constexpr fraction_column_view() noexcept = default;
+  constexpr fraction_column_view(const T* first, size_type count) noexcept : first{first}, count{count} {}
+
+  constexpr const T* data() const noexcept { return first; }
+  constexpr size_type size() const noexcept { return count; }
+  constexpr bool empty() const noexcept { return count == 0; }
+
+  constexpr const T& operator[](size_type index) const noexcept { return first[index]; }
+
+  constexpr iterator begin() const noexcept { return first; }
+  constexpr iterator end() const noexcept { return first + count; }
+};
+
+/*!
+ * @brief Memory mapped file of fractions, stored as a numerator and a denominator column
+ *
+ * The file is mapped read only and the columns are handed out in place, so opening a file costs the same no matter
+ * how large it is. Only the pages that are actually read get loaded.
+ *
+ * The file starts with a header that holds the type, the number of fractions, the byte order and whether all
+ * fractions are reduced. It's followed by the numerator column, the denominator column and the minimum and maximum of
+ * every block of @c blockSize() fractions, so a scan can skip whole blocks. Each of them starts on a 64 byte boundary.
+ * Files are written with @c writeFractionFile and can only be read on machines with the same byte order.
+ *
+ * @tparam T       Integer type of numerators and denominators
+ * @tparam CHECK_T Used for checking if @p T is an integer type
+ */
+template <class T = std::int64_t, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+class fraction_file {
+ public:
+  typedef fraction<T, CHECK_T> fraction_type;
+  typedef std::size_t size_type;
+
+ private:
+  details::mapped_file file;
+  details::fraction_file_header header;
+
+ public:
+  /*!
+   * @brief Maps the file at @p path
+   *
+   * @throws std::runtime_error when the file can't be opened or mapped.
+   * @throws std::invalid_argument when the file isn't a fraction file of @p T with the byte order of this machine, or
+   * is truncated.
+   */
+  explicit fraction_file(const std::string& path);
+
+  size_type size() const noexcept;
+  bool empty() const noexcept;
+
+  /*!
+   * @brief Whether the writer recorded all fractions as reduced
+   *
+   * Only a hint for readers of the columns. The file may have been changed since, so the element access reduces the
+   * fractions either way.
+   */
+  bool allReduced() const noexcept;
+
+  /*!
+   * @brief Fraction at @p index, reduced
+   *
+   * @throws std::invalid_argument when the stored denominator is 0.
+   * @throws std::overflow_error when the stored fraction can't be normalized.
+   */
+  fraction_type operator[](size_type index) const;
+  /*!
+   * @copydoc operator[]
+   * @throws std::out_of_range when @p index isn't smaller than @c size().
+   */
+  fraction_type at(size_type index) const;
+
+  /// Zero copy view of the numerator column. Valid as long as the file is
+  fraction_column_view<T> numerators() const noexcept;
+  /// Zero copy view of the denominator column, as stored. Valid as long as the file is
+  fraction_column_view<T> denominators() const noexcept;
+
+  /// Number of fractions each block summary covers. Only the last block may be shorter
+  size_type blockSize() const noexcept;
+  size_type blockCount() const noexcept;
+  /*!
+   * @brief Smallest fraction of the block at @p block
+   *
+   * @throws std::invalid_argument when the stored denominator is 0.
+   * @throws std::overflow_error when the stored fraction can't be normalized.
+   */
+  fraction_type blockMin(size_type block) const;
+  /// @copydoc blockMin
+  fraction_type blockMax(size_type block) const;
+
+ private:
+  const T* column(std::uint64_t offset) const noexcept;
+};
+
+/*!
+ * @brief Writes a fraction file that @c fraction_file can map
+ *
+ * The columns don't need to be reduced. Whether they are is recorded in the header.
+ *
+ * @param[in] path         File to create or overwrite
+ * @param[in] numerators   Array of @p count numerators
+ * @param[in] denominators Array of @p count denominators
+ * @param[in] count        Number of fractions
+ * @param[in] blockSize    Number of fractions each block summary covers
+ *
+ * @throws std::invalid_argument when a denominator isn't positive, or @p blockSize is 0.
+ * @throws std::runtime_error when the file can't be written.
+ */
+template <class T, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+void writeFractionFile(const std::string& path, const T* numerators, const T* denominators, std::size_t count,
+                       std::size_t blockSize = 4096);
+
+/// Writes all fractions of @p values. Same as the column overload
+template <class T, class CHECK_T>
+void writeFractionFile(const std::string& path, const fraction_vector<T, CHECK_T>& values,
+                       std::size_t blockSize = 4096);
+
+/// Writes @p count fractions. Same as the column overload
+template <class T, class CHECK_T>
+void writeFractionFile(const std::string& path, const fraction<T, CHECK_T>* values, std::size_t count,
+                       std::size_t blockSize = 4096);
+
+////////////////////////////////////////////////////////////
+// Implementation
+////////////////////////////////////////////////////////////
+
+template <class T, class CHECK_T>
+inline fraction_file<T, CHECK_T>::fraction_file(const std::string& path) : file{path}, header{} {
+  typedef details::fraction_file_header header_type;
+
+  constexpr std::uint32_t signedFlag{std::is_signed<T>::value ? header_type::flagSigned : 0U};
+
+  const std::uint64_t fileSize{file.getSize()};
+
+  if (fileSize < sizeof(header_type)) throw std::invalid_argument("The file is not a fraction file!");
+
+  std::memcpy(&header, file.getData(), sizeof(header_type));
+
+  if (std::memcmp(header.magic, header_type::expectedMagic, sizeof(header.magic)) != 0)
+    throw std::invalid_argument("The file is not a fraction file!");
+  if (header.byteOrder != header_type::nativeByteOrder)
+    throw std::invalid_argument("The fraction file has a different byte order!");
+  if (header.version != header_type::currentVersion)
+    throw std::invalid_argument("The version of the fraction file is not supported!");
+  if ((header.valueSize != sizeof(T)) || ((header.flags & header_type::flagSigned) != signedFlag))
+    throw std::invalid_argument("The fraction file holds a different type!");
+  if ((header.blockSize == 0) || (header.count > (std::numeric_limits<std::uint64_t>::max() / (4 * sizeof(T)))))
+    throw std::invalid_argument("The fraction file is corrupt!");
+
+  const std::uint64_t columnSize{header.count * sizeof(T)};
+  const std::uint64_t summarySize{blockCount() * 4 * sizeof(T)};
+  const auto fits = [fileSize](std::uint64_t offset, std::uint64_t size) {
+    return ((offset % alignof(T)) == 0) && (offset <= fileSize) && (size <= (fileSize - offset));
+  };
+
+  if (!fits(header.numeratorOffset, columnSize) || !fits(header.denominatorOffset, columnSize) ||
+      !fits(header.summaryOffset, summarySize))
+    throw std::invalid_argument("The fraction file is truncated!");
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_file<T, CHECK_T>::size_type fraction_file<T, CHECK_T>::size() const noexcept {
+  return static_cast<size_type>(header.count);
+}
+
+template <class T, class CHECK_T>
+inline bool fraction_file<T, CHECK_T>::empty() const noexcept {
+  return header.count == 0;
+}
+
+template <class T, class CHECK_T>
+inline bool fraction_file<T, CHECK_T>::allReduced() const noexcept {
+  return (header.flags & details::fraction_file_header::flagAllReduced) != 0;
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_file<T, CHECK_T>::fraction_type fraction_file<T, CHECK_T>::operator[](
+    size_type index) const {
+  // The mapped file isn't trusted, so even fractions flagged as reduced go through the checking constructor
+  return fraction_type{column(header.numeratorOffset)[index], column(header.denominatorOffset)[index]};
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_file<T, CHECK_T>::fraction_type fraction_file<T, CHECK_T>::at(size_type index) const {
+  if (index >= size()) throw std::out_of_range("The index is out of range!");
+
+  return (*this)[index];
+}
+
+template <class T, class CHECK_T>
+inline fraction_column_view<T> fraction_file<T, CHECK_T>::numerators() const noexcept {
+  return {column(header.numeratorOffset), size()};
+}
+
+template <class T, class CHECK_T>
+inline fraction_column_view<T> fraction_file<T, CHECK_T>::denominators() const noexcept {
+  return {column(header.denominatorOffset), size()};
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_file<T, CHECK_T>::size_type fraction_file<T, CHECK_T>::blockSize() const noexcept {
+  return static_cast<size_type>(header.blockSize);
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_file<T, CHECK_T>::size_type fraction_file<T, CHECK_T>::blockCount() const noexcept {
+  // Rounds up without adding to the count, as a huge block size from the file would wrap around
+  return static_cast<size_type>((header.count / header.blockSize) + ((header.count % header.blockSize) != 0));
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_file<T, CHECK_T>::fraction_type fraction_file<T, CHECK_T>::blockMin(
+    size_type block) const {
+  const T* const summary{column(header.summaryOffset) + (4 * block)};
+
+  return fraction_type{summary[0], summary[1]};
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_file<T, CHECK_T>::fraction_type fraction_file<T, CHECK_T>::blockMax(
+    size_type block) const {
+  const T* const summary{column(header.summaryOffset) + (4 * block)};
+
+  return fraction_type{summary[2], summary[3]};
+}
+
+template <class T, class CHECK_T>
+inline const T* fraction_file<T, CHECK_T>::column(std::uint64_t offset) const noexcept {
+  // The offsets are aligned for T, and the mapping is aligned to a page
+  return reinterpret_cast<const T*>(file.getData() + offset);
+}
+
+template <class T, class CHECK_T>
+inline void writeFractionFile(const std::string& path, const T* numerators, const T* denominators, std::size_t count,
+                              std::size_t blockSize) {
+  typedef details::fraction_file_header header_type;
+  typedef fraction<T, CHECK_T> fraction_type;
+
+  if (blockSize == 0) throw std::invalid_argument("The block size must be at least 1!");
+
+  // Checking the denominators, reducedness and the block summaries all need the reduced values
+  const std::size_t blockCount{(count / blockSize) + ((count % blockSize) != 0)};
+  std::vector<T> summaries(4 * blockCount);
+  bool allReduced{true};
+
+  for (std::size_t block = 0; block < blockCount; ++block) {
+    const std::size_t begin{block * blockSize};
+    const std::size_t end{((count - begin) < blockSize) ? count : (begin + blockSize)};
+    fraction_type min{};
+    fraction_type max{};
+
+    for (std::size_t i = begin; i < end; ++i) {
+      if (!(denominators[i] > T{0})) throw std::invalid_argument("The denominator must be positive!");
+
+      const fraction_type value{numerators[i], denominators[i]};
+
+      allReduced = allReduced && (value.getNumerator() == numerators[i]) && (value.getDenominator() == denominators[i]);
+
+      if ((i == begin) || (value < min)) min = value;
+      if ((i == begin) || (value > max)) max = value;
+    }
+
+    summaries[(4 * block) + 0] = min.getNumerator();
+    summaries[(4 * block) + 1] = min.getDenominator();
+    summaries[(4 * block) + 2] = max.getNumerator();
+    summaries[(4 * block) + 3] = max.getDenominator();
+  }
+
+  header_type header{};
+  const std::uint64_t columnSize{static_cast<std::uint64_t>(count) * sizeof(T)};
+
+  std::memcpy(header.magic, header_type::expectedMagic, sizeof(header.magic));
+  header.version = header_type::currentVersion;
+  header.byteOrder = header_type::nativeByteOrder;
+  header.valueSize = sizeof(T);
+  header.flags = (std::is_signed<T>::value ? header_type::flagSigned : 0U) |
+                 (allReduced ? header_type::flagAllReduced : 0U);
+  header.count = count;
+  header.blockSize = blockSize;
+  header.numeratorOffset = details::alignFileOffset(sizeof(header_type));
+  header.denominatorOffset = details::alignFileOffset(header.numeratorOffset + columnSize);
+  header.summaryOffset = details::alignFileOffset(header.denominatorOffset + columnSize);
+
+  std::ofstream stream{path, std::ios_base::binary | std::ios_base::trunc};
+  std::uint64_t position{0};
+  const auto write = [&stream, &position](std::uint64_t offset, const void* data, std::uint64_t size) {
+    static constexpr char padding[details::fractionFileAlignment]{};
+
+    stream.write(padding, static_cast<std::streamsize>(offset - position));
+    stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    position = offset + size;
+  };
+
+  write(0, &header, sizeof(header_type));
+  write(header.numeratorOffset, numerators, columnSize);
+  write(header.denominatorOffset, denominators, columnSize);
+  write(header.summaryOffset, summaries.data(), summaries.size() * sizeof(T));
+  stream.close();
+
+  if (!stream) throw std::runtime_error("The fraction file could not be written!");
+}
+
+template <class T, class CHECK_T>
+inline void writeFractionFile(const std::string& path, const fraction_vector<T, CHECK_T>& values,
+                              std::size_t blockSize) {
+  writeFractionFile<T, CHECK_T>(path, values.numeratorData(), values.denominatorData(), values.size(), blockSize);
+}
+
+template <class T, class CHECK_T>
+inline void writeFractionFile(const std::string& path, const fraction<T, CHECK_T>* values, std::size_t count,
+                              std::size_t blockSize) {
+  std::vector<T> numerators(count);
+  std::vector<T> denominators(count);
+
+  for (std::size_t i = 0; i < count; ++i) {
+    numerators[i] = values[i].getNumerator();
+    denominators[i] = values[i].getDenominator();
+  }
+
+  writeFractionFile<T, CHECK_T>(path, numerators.data(), denominators.data(), count, blockSize);
+}
+
+#endif  // !FRACTION_FRACTION_FILE_HPP_
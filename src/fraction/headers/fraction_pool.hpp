@@ -0,0 +1,328 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#pragma once
+#ifndef FRACTION_FRACTION_POOL_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+#include "fraction.hpp"
+
+////////////////////////////////////////////////////////////
+// Declarations
+////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Interns fractions as 32 bit handles
+ *
+ * Every distinct fraction is stored once, and equal fractions always get the same handle. So data with few distinct
+ * values can store handles instead of fractions and compare them directly. Results of arithmetic on handles are
+ * memoized in a bounded cache, which turns repeated operations into a lookup.
+ *
+ * The pool is split into shards by the hash of the value, each with its own lock, so threads interning different
+ * values rarely wait for each other. Looking up the value of a handle never locks. Values never move, so references to
+ * them stay valid as long as the pool does.
+ *
+ * @tparam T       Integer type of numerators and denominators
+ * @tparam CHECK_T Used for checking if @p T is an integer type
+ */
+template <class T = std::int64_t, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+class fraction_pool {
+ public:
+  typedef fraction<T, CHECK_T> fraction_type;
+  typedef std::uint32_t handle_type;
+  typedef std::size_t size_type;
+
+ private:
+  // Constants
+  static constexpr unsigned SHARD_BITS{4};
+  static constexpr size_type SHARD_COUNT{size_type{1} << SHARD_BITS};
+  static constexpr unsigned INDEX_BITS{32 - SHARD_BITS};
+  static constexpr handle_type INDEX_MASK{(handle_type{1} << INDEX_BITS) - 1};
+  /// Size of the first chunk of a shard. Every further chunk doubles the capacity
+  static constexpr size_type FIRST_CHUNK_SIZE{64};
+  /// Number of chunks needed to reach the last index. The last one is clamped to the remaining handles
+  static constexpr size_type CHUNK_COUNT{
+      static_cast<size_type>(details::bitWidth(static_cast<std::uint64_t>((INDEX_MASK / FIRST_CHUNK_SIZE) + 1)))};
+
+  enum class operation : std::uint8_t { add, subtract, multiply, divide };
+
+  /// Values of one shard. Stored in chunks that never move, so readers don't need the lock
+  struct shard {
+    std::mutex mutex;
+    std::unordered_map<fraction_type, handle_type> handles;
+    std::array<std::atomic<fraction_type*>, CHUNK_COUNT> chunks{};
+    std::atomic<handle_type> size{0};
+  };
+
+  struct cache_entry {
+    handle_type lhs;
+    handle_type rhs;
+    handle_type result;
+    operation op;
+    bool valid;
+  };
+
+  // Fields
+  std::array<shard, SHARD_COUNT> shards;
+  std::unique_ptr<cache_entry[]> cache;
+  size_type cacheMask;
+  /// Locks for the cache entries, picked by the index of the entry
+  std::array<std::mutex, SHARD_COUNT> cacheLocks;
+
+ public:
+  /*!
+   * @brief Creates an empty pool
+   *
+   * @param[in] cacheSize Number of results the operation cache holds. Rounded up to a power of 2. 0 disables the cache
+   *
+   * @throws std::length_error when @p cacheSize can't be rounded up to a power of 2.
+   */
+  explicit fraction_pool(size_type cacheSize = 65536);
+
+  fraction_pool(const fraction_pool&) = delete;
+  ~fraction_pool();
+
+  fraction_pool& operator=(const fraction_pool&) = delete;
+
+  /*!
+   * @brief Returns the handle of @p value, adding it if it's new
+   *
+   * @throws std::overflow_error when the shard of @p value is full.
+   */
+  handle_type intern(const fraction_type& value);
+
+  /// Number of distinct fractions in the pool
+  size_type size() const noexcept;
+  size_type cacheSize() const noexcept;
+
+  /// Value of @p handle, which has to come from this pool
+  const fraction_type& operator[](handle_type handle) const noexcept;
+  /// @throws std::out_of_range when @p handle doesn't belong to this pool.
+  const fraction_type& at(handle_type handle) const;
+
+  /*!
+   * @brief Interned result of an operation on two interned values
+   *
+   * Results are cached, so repeating an operation only costs a lookup.
+   *
+   * @throws std::overflow_error when the result doesn't fit into the fraction.
+   */
+  handle_type add(handle_type lhs, handle_type rhs);
+  /// @copydoc add
+  handle_type subtract(handle_type lhs, handle_type rhs);
+  /// @copydoc add
+  handle_type multiply(handle_type lhs, handle_type rhs);
+  /*!
+   * @copydoc add
+   * @throws std::invalid_argument when @p rhs is 0.
+   */
+  handle_type divide(handle_type lhs, handle_type rhs);
+
+ private:
+  static constexpr size_type chunkIndex(size_type index) noexcept;
+  static constexpr size_type chunkStart(size_type chunk) noexcept;
+
+  const fraction_type* find(handle_type handle) const noexcept;
+  handle_type apply(operation op, handle_type lhs, handle_type rhs);
+};
+
+////////////////////////////////////////////////////////////
+// Implementation
+////////////////////////////////////////////////////////////
+
+template <class T, class CHECK_T>
+inline fraction_pool<T, CHECK_T>::fraction_pool(size_type cacheSize) : cacheMask{0} {
+  if (cacheSize > 0) {
+    if (cacheSize > ((std::numeric_limits<size_type>::max() >> 1) + 1))
+      throw std::length_error("The cache size of the fraction pool is too large!");
+
+    size_type roundedSize{1};
+
+    while (roundedSize < cacheSize) roundedSize <<= 1;
+
+    cache.reset(new cache_entry[roundedSize]{});
+    cacheMask = roundedSize - 1;
+  }
+}
+
+template <class T, class CHECK_T>
+inline fraction_pool<T, CHECK_T>::~fraction_pool() {
+  for (shard& currentShard : shards) {
+    for (std::atomic<fraction_type*>& chunk : currentShard.chunks) delete[] chunk.load(std::memory_order_relaxed);
+  }
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_pool<T, CHECK_T>::handle_type fraction_pool<T, CHECK_T>::intern(const fraction_type& value) {
+  // The hash is well mixed, so its top bits spread the values evenly over the shards
+  const std::size_t hash{std::hash<fraction_type>{}(value)};
+  const handle_type shardIndex{static_cast<handle_type>(hash >> ((sizeof(std::size_t) * 8) - SHARD_BITS))};
+  shard& currentShard{shards[shardIndex]};
+
+  std::lock_guard<std::mutex> lock{currentShard.mutex};
+
+  const auto found = currentShard.handles.find(value);
+
+  if (found != currentShard.handles.end()) return found->second;
+
+  const handle_type index{currentShard.size.load(std::memory_order_relaxed)};
+
+  if (index > INDEX_MASK) throw std::overflow_error("The fraction pool is full!");
+
+  const size_type chunk{chunkIndex(index)};
+  fraction_type* values{currentShard.chunks[chunk].load(std::memory_order_relaxed)};
+
+  if (values == nullptr) {
+    // The last chunk only holds the handles that are left below INDEX_MASK
+    const size_type chunkSize{
+        std::min<size_type>(FIRST_CHUNK_SIZE << chunk, (size_type{INDEX_MASK} + 1) - chunkStart(chunk))};
+
+    values = new fraction_type[chunkSize];
+    currentShard.chunks[chunk].store(values, std::memory_order_release);
+  }
+
+  const handle_type handle{(shardIndex << INDEX_BITS) | index};
+
+  currentShard.handles.emplace(value, handle);
+  values[index - chunkStart(chunk)] = value;
+  currentShard.size.store(index + 1, std::memory_order_release);
+
+  return handle;
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_pool<T, CHECK_T>::size_type fraction_pool<T, CHECK_T>::size() const noexcept {
+  size_type total{0};
+
+  for (const shard& currentShard : shards) total += currentShard.size.load(std::memory_order_relaxed);
+
+  return total;
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_pool<T, CHECK_T>::size_type fraction_pool<T, CHECK_T>::cacheSize() const noexcept {
+  return cache ? (cacheMask + 1) : 0;
+}
+
+template <class T, class CHECK_T>
+inline const typename fraction_pool<T, CHECK_T>::fraction_type& fraction_pool<T, CHECK_T>::operator[](
+    handle_type handle) const noexcept {
+  return *find(handle);
+}
+
+template <class T, class CHECK_T>
+inline const typename fraction_pool<T, CHECK_T>::fraction_type& fraction_pool<T, CHECK_T>::at(
+    handle_type handle) const {
+  const shard& currentShard{shards[handle >> INDEX_BITS]};
+
+  if ((handle & INDEX_MASK) >= currentShard.size.load(std::memory_order_acquire))
+    throw std::out_of_range("The handle does not belong to the fraction pool!");
+
+  return *find(handle);
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_pool<T, CHECK_T>::handle_type fraction_pool<T, CHECK_T>::add(handle_type lhs,
+                                                                                      handle_type rhs) {
+  return apply(operation::add, lhs, rhs);
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_pool<T, CHECK_T>::handle_type fraction_pool<T, CHECK_T>::subtract(handle_type lhs,
+                                                                                           handle_type rhs) {
+  return apply(operation::subtract, lhs, rhs);
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_pool<T, CHECK_T>::handle_type fraction_pool<T, CHECK_T>::multiply(handle_type lhs,
+                                                                                           handle_type rhs) {
+  return apply(operation::multiply, lhs, rhs);
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_pool<T, CHECK_T>::handle_type fraction_pool<T, CHECK_T>::divide(handle_type lhs,
+                                                                                         handle_type rhs) {
+  return apply(operation::divide, lhs, rhs);
+}
+
+template <class T, class CHECK_T>
+inline constexpr typename fraction_pool<T, CHECK_T>::size_type fraction_pool<T, CHECK_T>::chunkIndex(
+    size_type index) noexcept {
+  // Chunk k starts at FIRST_CHUNK_SIZE * (2^k - 1)
+  return static_cast<size_type>(details::bitWidth(static_cast<std::uint64_t>((index / FIRST_CHUNK_SIZE) + 1)) - 1);
+}
+
+template <class T, class CHECK_T>
+inline constexpr typename fraction_pool<T, CHECK_T>::size_type fraction_pool<T, CHECK_T>::chunkStart(
+    size_type chunk) noexcept {
+  return FIRST_CHUNK_SIZE * ((size_type{1} << chunk) - 1);
+}
+
+template <class T, class CHECK_T>
+inline const typename fraction_pool<T, CHECK_T>::fraction_type* fraction_pool<T, CHECK_T>::find(
+    handle_type handle) const noexcept {
+  const size_type index{handle & INDEX_MASK};
+  const size_type chunk{chunkIndex(index)};
+
+  return shards[handle >> INDEX_BITS].chunks[chunk].load(std::memory_order_acquire) + (index - chunkStart(chunk));
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_pool<T, CHECK_T>::handle_type fraction_pool<T, CHECK_T>::apply(operation op,
+                                                                                        handle_type lhs,
+                                                                                        handle_type rhs) {
+  const std::uint64_t key{(static_cast<std::uint64_t>(lhs) << 32) | rhs};
+  const size_type slot{static_cast<size_type>(details::mixHash(key + static_cast<std::uint64_t>(op))) & cacheMask};
+
+  if (cache) {
+    std::lock_guard<std::mutex> lock{cacheLocks[slot % SHARD_COUNT]};
+    const cache_entry& entry{cache[slot]};
+
+    if (entry.valid && (entry.lhs == lhs) && (entry.rhs == rhs) && (entry.op == op)) return entry.result;
+  }
+
+  const fraction_type& lhsValue{(*this)[lhs]};
+  const fraction_type& rhsValue{(*this)[rhs]};
+  fraction_type value{};
+
+  switch (op) {
+    case operation::add:
+      value = lhsValue + rhsValue;
+      break;
+    case operation::subtract:
+      value = lhsValue - rhsValue;
+      break;
+    case operation::multiply:
+      value = lhsValue * rhsValue;
+      break;
+    case operation::divide:
+      value = lhsValue / rhsValue;
+      break;
+  }
+
+  const handle_type result{intern(value)};
+
+  if (cache) {
+    std::lock_guard<std::mutex> lock{cacheLocks[slot % SHARD_COUNT]};
+
+    // The cache is direct mapped, so a new result simply replaces the old one
+    cache[slot] = cache_entry{lhs, rhs, result, op, true};
+  }
+
+  return result;
+}
+
+#endif  // !FRACTION_FRACTION_POOL_HPP_
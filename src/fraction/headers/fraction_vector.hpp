@@ -0,0 +1,730 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#pragma once
+#ifndef FRACTION_FRACTION_VECTOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "fraction.hpp"
+#include "fraction_batch.hpp"
+
+////////////////////////////////////////////////////////////
+// Details
+////////////////////////////////////////////////////////////
+
+namespace details {
+/// Allocator that places the storage on an @p ALIGNMENT byte boundary
+template <class T, std::size_t ALIGNMENT>
+struct aligned_allocator {
+  typedef T value_type;
+
+  template <class U>
+  struct rebind {
+    typedef aligned_allocator<U, ALIGNMENT> other;
+  };
+
+  constexpr aligned_allocator() noexcept = default;
+  template <class U>
+  constexpr aligned_allocator(const aligned_allocator<U, ALIGNMENT>&) noexcept {}
+
+  T* allocate(std::size_t count) {
+    if (count > (std::numeric_limits<std::size_t>::max() / sizeof(T))) throw std::bad_array_new_length{};
+
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ALIGNMENT}));
+  }
+
+  void deallocate(T* pointer, std::size_t) noexcept { ::operator delete(pointer, std::align_val_t{ALIGNMENT}); }
+
+  friend constexpr bool operator==(const aligned_allocator&, const aligned_allocator&) noexcept { return true; }
+  friend constexpr bool operator!=(const aligned_allocator&, const aligned_allocator&) noexcept { return false; }
+};
+}  // namespace details
+
+////////////////////////////////////////////////////////////
+// Declarations
+////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Sequence of fractions stored as a structure of arrays
+ *
+ * Numerators and denominators live in two separate, aligned arrays. So kernels can stream over a single column and
+ * vectorize, and both columns can be handed out without copying. All elements are reduced, just like @c fraction.
+ *
+ * Since no @c fraction is stored, element access hands out proxies (@c reference) that convert to and assign from
+ * @c fraction. Iterators are random access with these proxies, like the ones of @c std::vector<bool>.
+ *
+ * @tparam T       Integer type of numerators and denominators
+ * @tparam CHECK_T Used for checking if @p T is an integer type
+ */
+template <class T = std::int64_t, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+class fraction_vector {
+ public:
+  typedef fraction<T, CHECK_T> fraction_type;
+  typedef fraction_type value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  /// Alignment of both columns in bytes. Enough for a cache line and any SIMD register
+  static constexpr std::size_t alignment{64};
+
+ private:
+  typedef std::vector<T, details::aligned_allocator<T, alignment>> column_type;
+
+  enum class operation : std::uint8_t { add, subtract, multiply, divide };
+
+  // Fields
+  column_type numerators;
+  column_type denominators;
+
+ public:
+  /// Proxy for a single element
+  class reference {
+   public:
+    reference(const reference& copy) noexcept = default;
+
+    /// Assigns the value, not the proxy
+    reference& operator=(const reference& rhs) noexcept { return *this = static_cast<fraction_type>(rhs); }
+    reference& operator=(const fraction_type& rhs) noexcept {
+      *numerator = rhs.getNumerator();
+      *denominator = rhs.getDenominator();
+
+      return *this;
+    }
+
+    operator fraction_type() const noexcept { return fraction_vector<T, CHECK_T>::load(*numerator, *denominator); }
+
+    const T& getNumerator() const noexcept { return *numerator; }
+    const T& getDenominator() const noexcept { return *denominator; }
+
+    reference& operator+=(const fraction_type& rhs) { return *this = static_cast<fraction_type>(*this) + rhs; }
+    reference& operator-=(const fraction_type& rhs) { return *this = static_cast<fraction_type>(*this) - rhs; }
+    reference& operator*=(const fraction_type& rhs) { return *this = static_cast<fraction_type>(*this) * rhs; }
+    reference& operator/=(const fraction_type& rhs) { return *this = static_cast<fraction_type>(*this) / rhs; }
+
+    friend void swap(reference lhs, reference rhs) noexcept {
+      const fraction_type value{lhs};
+
+      lhs = rhs;
+      rhs = value;
+    }
+
+    // The operators of fraction are templates, which don't consider the conversion of the proxy
+    friend fraction_type operator+(const fraction_type& lhs, const fraction_type& rhs) { return lhs + rhs; }
+    friend fraction_type operator-(const fraction_type& lhs, const fraction_type& rhs) { return lhs - rhs; }
+    friend fraction_type operator*(const fraction_type& lhs, const fraction_type& rhs) { return lhs * rhs; }
+    friend fraction_type operator/(const fraction_type& lhs, const fraction_type& rhs) { return lhs / rhs; }
+
+    friend bool operator==(const fraction_type& lhs, const fraction_type& rhs) noexcept { return lhs == rhs; }
+    friend bool operator!=(const fraction_type& lhs, const fraction_type& rhs) noexcept { return lhs != rhs; }
+    friend bool operator<(const fraction_type& lhs, const fraction_type& rhs) noexcept { return lhs < rhs; }
+    friend bool operator>(const fraction_type& lhs, const fraction_type& rhs) noexcept { return lhs > rhs; }
+    friend bool operator<=(const fraction_type& lhs, const fraction_type& rhs) noexcept { return lhs <= rhs; }
+    friend bool operator>=(const fraction_type& lhs, const fraction_type& rhs) noexcept { return lhs >= rhs; }
+
+    template <class charT, class traits>
+    friend std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, traits>& ostream,
+                                                         const reference& value) {
+      return ostream << static_cast<fraction_type>(value);
+    }
+
+   private:
+    friend class fraction_vector<T, CHECK_T>;
+
+    reference(T* numerator, T* denominator) noexcept : numerator{numerator}, denominator{denominator} {}
+
+    T* numerator;
+    T* denominator;
+  };
+
+  typedef fraction_type const_reference;
+
+  /// Random access iterator. Dereferences to a @c reference, or to a @c fraction for @p CONST iterators
+  template <bool CONST>
+  class basic_iterator {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef fraction_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef typename std::conditional<CONST, fraction_type, typename fraction_vector<T, CHECK_T>::reference>::type
+        reference;
+
+    basic_iterator() noexcept = default;
+    /// Iterators convert to const iterators
+    template <bool OTHER_CONST, class CHECK_CONST = typename std::enable_if<CONST && !OTHER_CONST>::type>
+    basic_iterator(const basic_iterator<OTHER_CONST>& other) noexcept : owner{other.owner}, index{other.index} {}
+
+    reference operator*() const noexcept { return (*owner)[index]; }
+    reference operator[](difference_type offset) const noexcept { return (*owner)[index + offset]; }
+
+    basic_iterator& operator++() noexcept {
+      ++index;
+
+      return *this;
+    }
+    basic_iterator operator++(int) noexcept { return basic_iterator{owner, index++}; }
+    basic_iterator& operator--() noexcept {
+      --index;
+
+      return *this;
+    }
+    basic_iterator operator--(int) noexcept { return basic_iterator{owner, index--}; }
+
+    basic_iterator& operator+=(difference_type offset) noexcept {
+      index += offset;
+
+      return *this;
+    }
+    basic_iterator& operator-=(difference_type offset) noexcept {
+      index -= offset;
+
+      return *this;
+    }
+
+    friend basic_iterator operator+(basic_iterator lhs, difference_type rhs) noexcept { return lhs += rhs; }
+    friend basic_iterator operator+(difference_type lhs, basic_iterator rhs) noexcept { return rhs += lhs; }
+    friend basic_iterator operator-(basic_iterator lhs, difference_type rhs) noexcept { return lhs -= rhs; }
+    friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+      return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+    }
+
+    friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+      return lhs.index == rhs.index;
+    }
+    friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+      return lhs.index != rhs.index;
+    }
+    friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+      return lhs.index < rhs.index;
+    }
+    friend bool operator>(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+      return lhs.index > rhs.index;
+    }
+    friend bool operator<=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+      return lhs.index <= rhs.index;
+    }
+    friend bool operator>=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+      return lhs.index >= rhs.index;
+    }
+
+   private:
+    typedef typename std::conditional<CONST, const fraction_vector<T, CHECK_T>, fraction_vector<T, CHECK_T>>::type
+        owner_type;
+
+    friend class fraction_vector<T, CHECK_T>;
+    template <bool OTHER_CONST>
+    friend class basic_iterator;
+
+    basic_iterator(owner_type* owner, size_type index) noexcept : owner{owner}, index{index} {}
+
+    owner_type* owner{nullptr};
+    size_type index{0};
+  };
+
+  typedef basic_iterator<false> iterator;
+  typedef basic_iterator<true> const_iterator;
+
+  // Constructors
+  fraction_vector() = default;
+  explicit fraction_vector(size_type count, const fraction_type& value = fraction_type{});
+  fraction_vector(std::initializer_list<fraction_type> values);
+
+  /*!
+   * @brief Column constructor
+   *
+   * Copies both columns and reduces all fractions with @c reduceBatch.
+   *
+   * @throws std::invalid_argument when a denominator is 0.
+   * @throws std::overflow_error when a reduced fraction doesn't fit into @p T.
+   */
+  fraction_vector(const T* numerators, const T* denominators, size_type count);
+
+  // Capacity
+  size_type size() const noexcept;
+  bool empty() const noexcept;
+  void reserve(size_type capacity);
+
+  // Modifiers
+  void clear() noexcept;
+  void resize(size_type count, const fraction_type& value = fraction_type{});
+  void push_back(const fraction_type& value);
+  void pop_back();
+
+  // Element access
+  reference operator[](size_type index) noexcept;
+  const_reference operator[](size_type index) const noexcept;
+
+  /// @throws std::out_of_range when @p index isn't smaller than @c size().
+  reference at(size_type index);
+  /// @throws std::out_of_range when @p index isn't smaller than @c size().
+  const_reference at(size_type index) const;
+
+  /// Zero copy view of the numerator column. Valid for @c size() elements until the vector is modified
+  const T* numeratorData() const noexcept;
+  /// Zero copy view of the denominator column. Always positive. Valid for @c size() elements until the vector is
+  /// modified
+  const T* denominatorData() const noexcept;
+
+  // Iterators
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  // Arithmetic operators
+  // They apply element wise. Vector operands need to have the same size, or std::invalid_argument is thrown. The
+  // results are computed unreduced and then reduced all at once with reduceBatch. When an element throws, the vector
+  // is left unchanged
+
+  fraction_vector<T, CHECK_T>& operator+=(const fraction_type& rhs);
+  fraction_vector<T, CHECK_T>& operator+=(const fraction_vector<T, CHECK_T>& rhs);
+  fraction_vector<T, CHECK_T>& operator-=(const fraction_type& rhs);
+  fraction_vector<T, CHECK_T>& operator-=(const fraction_vector<T, CHECK_T>& rhs);
+  fraction_vector<T, CHECK_T>& operator*=(const fraction_type& rhs);
+  fraction_vector<T, CHECK_T>& operator*=(const fraction_vector<T, CHECK_T>& rhs);
+  fraction_vector<T, CHECK_T>& operator/=(const fraction_type& rhs);
+  fraction_vector<T, CHECK_T>& operator/=(const fraction_vector<T, CHECK_T>& rhs);
+
+  friend fraction_vector<T, CHECK_T> operator+(fraction_vector<T, CHECK_T> lhs,
+                                               const fraction_vector<T, CHECK_T>& rhs) {
+    return lhs += rhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator+(fraction_vector<T, CHECK_T> lhs, const fraction_type& rhs) {
+    return lhs += rhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator+(const fraction_type& lhs, fraction_vector<T, CHECK_T> rhs) {
+    return rhs += lhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator-(fraction_vector<T, CHECK_T> lhs,
+                                               const fraction_vector<T, CHECK_T>& rhs) {
+    return lhs -= rhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator-(fraction_vector<T, CHECK_T> lhs, const fraction_type& rhs) {
+    return lhs -= rhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator-(const fraction_type& lhs, fraction_vector<T, CHECK_T> rhs) {
+    rhs.apply(operation::subtract, [&](size_type) { return lhs; }, [&](size_type index) { return rhs.load(index); });
+
+    return rhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator*(fraction_vector<T, CHECK_T> lhs,
+                                               const fraction_vector<T, CHECK_T>& rhs) {
+    return lhs *= rhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator*(fraction_vector<T, CHECK_T> lhs, const fraction_type& rhs) {
+    return lhs *= rhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator*(const fraction_type& lhs, fraction_vector<T, CHECK_T> rhs) {
+    return rhs *= lhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator/(fraction_vector<T, CHECK_T> lhs,
+                                               const fraction_vector<T, CHECK_T>& rhs) {
+    return lhs /= rhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator/(fraction_vector<T, CHECK_T> lhs, const fraction_type& rhs) {
+    return lhs /= rhs;
+  }
+  friend fraction_vector<T, CHECK_T> operator/(const fraction_type& lhs, fraction_vector<T, CHECK_T> rhs) {
+    rhs.apply(operation::divide, [&](size_type) { return lhs; }, [&](size_type index) { return rhs.load(index); });
+
+    return rhs;
+  }
+
+  // Relational operators
+  friend bool operator==(const fraction_vector<T, CHECK_T>& lhs, const fraction_vector<T, CHECK_T>& rhs) {
+    return (lhs.numerators == rhs.numerators) && (lhs.denominators == rhs.denominators);
+  }
+  friend bool operator!=(const fraction_vector<T, CHECK_T>& lhs, const fraction_vector<T, CHECK_T>& rhs) {
+    return !(lhs == rhs);
+  }
+
+  // Kernels, see fraction_batch.hpp
+  friend fraction_type fractionSum(const fraction_vector<T, CHECK_T>& values) {
+    details::wide_accumulator<T, CHECK_T> sum{};
+
+    for (size_type index = 0; index < values.size(); ++index)
+      sum.add(values.load(index));
+
+    return sum.result();
+  }
+  friend fraction_type fractionDot(const fraction_vector<T, CHECK_T>& lhs, const fraction_vector<T, CHECK_T>& rhs) {
+    lhs.checkSize(rhs);
+
+    details::wide_accumulator<T, CHECK_T> sum{};
+
+    for (size_type index = 0; index < lhs.size(); ++index)
+      sum.addProduct(lhs.load(index), rhs.load(index));
+
+    return sum.result();
+  }
+  friend void fractionAxpy(const fraction_type& factor, const fraction_vector<T, CHECK_T>& x,
+                           fraction_vector<T, CHECK_T>& y) {
+    y.checkSize(x);
+    y.transform([&](size_type index) {
+      details::wide_accumulator<T, CHECK_T> sum{};
+
+      sum.addProduct(factor, x.load(index));
+      sum.add(y.load(index));
+
+      return sum.result();
+    });
+  }
+
+ private:
+  /// Builds the element from already reduced columns without another reduction
+  static constexpr fraction_type load(const T& numerator, const T& denominator) noexcept;
+  fraction_type load(size_type index) const noexcept;
+  void store(size_type index, const fraction_type& value) noexcept;
+
+  void checkSize(const fraction_vector<T, CHECK_T>& other) const;
+
+  /// Replaces every element with the result of @p operation, which is called with the index of the element
+  template <class OPERATION>
+  void transform(OPERATION operation);
+
+  /*!
+   * @brief Replaces every element with @p lhs @p op @p rhs
+   *
+   * @p lhs and @p rhs are called with the index of the element. The results are written unreduced to new columns,
+   * which are reduced with a single call to @c reduceBatch. Only results that don't fit into @p T before reducing are
+   * computed with the operators of @c fraction.
+   */
+  template <class LHS, class RHS>
+  void apply(operation op, LHS lhs, RHS rhs);
+
+  /// Unreduced result of @p lhs @p op @p rhs. Returns @c false instead when it doesn't fit into @p T
+  static constexpr bool applyUnreduced(operation op, const fraction_type& lhs, const fraction_type& rhs, T& numerator,
+                                       T& denominator) noexcept;
+  static constexpr fraction_type applyScalar(operation op, const fraction_type& lhs, const fraction_type& rhs);
+};
+
+////////////////////////////////////////////////////////////
+// Implementation
+////////////////////////////////////////////////////////////
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>::fraction_vector(size_type count, const fraction_type& value)
+    : numerators(count, value.getNumerator()), denominators(count, value.getDenominator()) {}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>::fraction_vector(std::initializer_list<fraction_type> values)
+    : numerators{}, denominators{} {
+  reserve(values.size());
+
+  for (const fraction_type& value : values)
+    push_back(value);
+}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>::fraction_vector(const T* numerators, const T* denominators, size_type count)
+    : numerators(numerators, numerators + count), denominators(denominators, denominators + count) {
+  reduceBatch(this->numerators.data(), this->denominators.data(), count);
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::size_type fraction_vector<T, CHECK_T>::size() const noexcept {
+  return numerators.size();
+}
+
+template <class T, class CHECK_T>
+inline bool fraction_vector<T, CHECK_T>::empty() const noexcept {
+  return numerators.empty();
+}
+
+template <class T, class CHECK_T>
+inline void fraction_vector<T, CHECK_T>::reserve(size_type capacity) {
+  numerators.reserve(capacity);
+  denominators.reserve(capacity);
+}
+
+template <class T, class CHECK_T>
+inline void fraction_vector<T, CHECK_T>::clear() noexcept {
+  numerators.clear();
+  denominators.clear();
+}
+
+template <class T, class CHECK_T>
+inline void fraction_vector<T, CHECK_T>::resize(size_type count, const fraction_type& value) {
+  const size_type oldSize{numerators.size()};
+
+  numerators.resize(count, value.getNumerator());
+
+  try {
+    denominators.resize(count, value.getDenominator());
+  } catch (...) {
+    numerators.resize(oldSize);
+
+    throw;
+  }
+}
+
+template <class T, class CHECK_T>
+inline void fraction_vector<T, CHECK_T>::push_back(const fraction_type& value) {
+  numerators.push_back(value.getNumerator());
+
+  try {
+    denominators.push_back(value.getDenominator());
+  } catch (...) {
+    numerators.pop_back();
+
+    throw;
+  }
+}
+
+template <class T, class CHECK_T>
+inline void fraction_vector<T, CHECK_T>::pop_back() {
+  numerators.pop_back();
+  denominators.pop_back();
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::reference fraction_vector<T, CHECK_T>::operator[](
+    size_type index) noexcept {
+  return reference{numerators.data() + index, denominators.data() + index};
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::const_reference fraction_vector<T, CHECK_T>::operator[](
+    size_type index) const noexcept {
+  return load(index);
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::reference fraction_vector<T, CHECK_T>::at(size_type index) {
+  if (index >= size()) throw std::out_of_range("The index is out of range!");
+
+  return (*this)[index];
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::const_reference fraction_vector<T, CHECK_T>::at(size_type index) const {
+  if (index >= size()) throw std::out_of_range("The index is out of range!");
+
+  return (*this)[index];
+}
+
+template <class T, class CHECK_T>
+inline const T* fraction_vector<T, CHECK_T>::numeratorData() const noexcept {
+  return numerators.data();
+}
+
+template <class T, class CHECK_T>
+inline const T* fraction_vector<T, CHECK_T>::denominatorData() const noexcept {
+  return denominators.data();
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::iterator fraction_vector<T, CHECK_T>::begin() noexcept {
+  return iterator{this, 0};
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::const_iterator fraction_vector<T, CHECK_T>::begin() const noexcept {
+  return const_iterator{this, 0};
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::const_iterator fraction_vector<T, CHECK_T>::cbegin() const noexcept {
+  return begin();
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::iterator fraction_vector<T, CHECK_T>::end() noexcept {
+  return iterator{this, size()};
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::const_iterator fraction_vector<T, CHECK_T>::end() const noexcept {
+  return const_iterator{this, size()};
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::const_iterator fraction_vector<T, CHECK_T>::cend() const noexcept {
+  return end();
+}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>& fraction_vector<T, CHECK_T>::operator+=(const fraction_type& rhs) {
+  apply(operation::add, [&](size_type index) { return load(index); }, [&](size_type) { return rhs; });
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>& fraction_vector<T, CHECK_T>::operator+=(const fraction_vector<T, CHECK_T>& rhs) {
+  checkSize(rhs);
+  apply(operation::add, [&](size_type index) { return load(index); },
+        [&](size_type index) { return rhs.load(index); });
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>& fraction_vector<T, CHECK_T>::operator-=(const fraction_type& rhs) {
+  apply(operation::subtract, [&](size_type index) { return load(index); }, [&](size_type) { return rhs; });
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>& fraction_vector<T, CHECK_T>::operator-=(const fraction_vector<T, CHECK_T>& rhs) {
+  checkSize(rhs);
+  apply(operation::subtract, [&](size_type index) { return load(index); },
+        [&](size_type index) { return rhs.load(index); });
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>& fraction_vector<T, CHECK_T>::operator*=(const fraction_type& rhs) {
+  apply(operation::multiply, [&](size_type index) { return load(index); }, [&](size_type) { return rhs; });
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>& fraction_vector<T, CHECK_T>::operator*=(const fraction_vector<T, CHECK_T>& rhs) {
+  checkSize(rhs);
+  apply(operation::multiply, [&](size_type index) { return load(index); },
+        [&](size_type index) { return rhs.load(index); });
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>& fraction_vector<T, CHECK_T>::operator/=(const fraction_type& rhs) {
+  apply(operation::divide, [&](size_type index) { return load(index); }, [&](size_type) { return rhs; });
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline fraction_vector<T, CHECK_T>& fraction_vector<T, CHECK_T>::operator/=(const fraction_vector<T, CHECK_T>& rhs) {
+  checkSize(rhs);
+  apply(operation::divide, [&](size_type index) { return load(index); },
+        [&](size_type index) { return rhs.load(index); });
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline constexpr typename fraction_vector<T, CHECK_T>::fraction_type fraction_vector<T, CHECK_T>::load(
+    const T& numerator, const T& denominator) noexcept {
+  return fraction_type{numerator, denominator, typename fraction_type::reduced_tag{}};
+}
+
+template <class T, class CHECK_T>
+inline typename fraction_vector<T, CHECK_T>::fraction_type fraction_vector<T, CHECK_T>::load(size_type index) const
+    noexcept {
+  return load(numerators[index], denominators[index]);
+}
+
+template <class T, class CHECK_T>
+inline void fraction_vector<T, CHECK_T>::store(size_type index, const fraction_type& value) noexcept {
+  numerators[index] = value.getNumerator();
+  denominators[index] = value.getDenominator();
+}
+
+template <class T, class CHECK_T>
+inline void fraction_vector<T, CHECK_T>::checkSize(const fraction_vector<T, CHECK_T>& other) const {
+  if (size() != other.size()) throw std::invalid_argument("The vectors must have the same size!");
+}
+
+template <class T, class CHECK_T>
+template <class OPERATION>
+inline void fraction_vector<T, CHECK_T>::transform(OPERATION operation) {
+  const size_type count{size()};
+
+  for (size_type index = 0; index < count; ++index)
+    store(index, operation(index));
+}
+
+template <class T, class CHECK_T>
+template <class LHS, class RHS>
+inline void fraction_vector<T, CHECK_T>::apply(operation op, LHS lhs, RHS rhs) {
+  const size_type count{size()};
+  column_type resultNumerators(count);
+  column_type resultDenominators(count);
+
+  for (size_type index = 0; index < count; ++index) {
+    const fraction_type lhsValue{lhs(index)};
+    const fraction_type rhsValue{rhs(index)};
+
+    if (applyUnreduced(op, lhsValue, rhsValue, resultNumerators[index], resultDenominators[index])) continue;
+
+    // Reducing an already reduced result again is cheap, so it can stay in the batch
+    const fraction_type result{applyScalar(op, lhsValue, rhsValue)};
+
+    resultNumerators[index] = result.getNumerator();
+    resultDenominators[index] = result.getDenominator();
+  }
+
+  reduceBatch(resultNumerators.data(), resultDenominators.data(), count);
+
+  numerators.swap(resultNumerators);
+  denominators.swap(resultDenominators);
+}
+
+template <class T, class CHECK_T>
+inline constexpr bool fraction_vector<T, CHECK_T>::applyUnreduced(operation op, const fraction_type& lhs,
+                                                                  const fraction_type& rhs, T& numerator,
+                                                                  T& denominator) noexcept {
+  const T& lhsNumerator{lhs.getNumerator()};
+  const T& lhsDenominator{lhs.getDenominator()};
+  const T& rhsNumerator{rhs.getNumerator()};
+  const T& rhsDenominator{rhs.getDenominator()};
+
+  switch (op) {
+    case operation::add:
+    case operation::subtract: {
+      T lhsPart{0};
+      T rhsPart{0};
+
+      return details::multiplyInto(lhsNumerator, rhsDenominator, lhsPart) &&
+             details::multiplyInto(rhsNumerator, lhsDenominator, rhsPart) &&
+             details::addInto(lhsPart, rhsPart, op == operation::subtract, numerator) &&
+             details::multiplyInto(lhsDenominator, rhsDenominator, denominator);
+    }
+    case operation::multiply:
+      return details::multiplyInto(lhsNumerator, rhsNumerator, numerator) &&
+             details::multiplyInto(lhsDenominator, rhsDenominator, denominator);
+    case operation::divide:
+      // A zero divisor gives a zero denominator, which reduceBatch rejects
+      return details::multiplyInto(lhsNumerator, rhsDenominator, numerator) &&
+             details::multiplyInto(lhsDenominator, rhsNumerator, denominator);
+  }
+
+  return false;
+}
+
+template <class T, class CHECK_T>
+inline constexpr typename fraction_vector<T, CHECK_T>::fraction_type fraction_vector<T, CHECK_T>::applyScalar(
+    operation op, const fraction_type& lhs, const fraction_type& rhs) {
+  switch (op) {
+    case operation::add:
+      return lhs + rhs;
+    case operation::subtract:
+      return lhs - rhs;
+    case operation::multiply:
+      return lhs * rhs;
+    case operation::divide:
+      return lhs / rhs;
+  }
+
+  return lhs;
+}
+
+#endif  // !FRACTION_FRACTION_VECTOR_HPP_
@@ -0,0 +1,381 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#pragma once
+#ifndef FRACTION_LAZY_FRACTION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "fraction.hpp"
+
+////////////////////////////////////////////////////////////
+// Declarations
+////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Fraction that defers its reduction
+ *
+ * Unlike @c fraction this type doesn't reduce after every operation. Numerator and denominator are only reduced when
+ * the next result wouldn't fit into @p T otherwise, or when converting to a @c fraction. Comparisons, stream output and
+ * conversions go through that conversion.
+ *
+ * This pays off in chains of operations like accumulation loops, where only the final value matters.
+ *
+ * @tparam T       Integer type of numerator and denominator
+ * @tparam CHECK_T Used for checking if @p T is an integer type
+ */
+template <class T = std::int64_t, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+class lazy_fraction {
+ public:
+  typedef T value_type;
+  typedef fraction<T, CHECK_T> fraction_type;
+
+ private:
+  // Constants
+  static constexpr T ZERO{0};
+  static constexpr T ONE{1};
+
+  typedef typename std::make_unsigned<T>::type unsigned_type;
+  typedef details::wide_t<T> wide_type;
+
+  // Fields
+  T numerator;
+  T denominator;
+
+ public:
+  /*!
+   * @brief Stores @p numerator / @p denominator without reducing it
+   *
+   * A negative denominator moves its sign to the numerator. Only when that doesn't fit, the fraction is reduced.
+   *
+   * @throws std::invalid_argument when @p denominator is 0.
+   * @throws std::overflow_error when even the reduced fraction doesn't fit into @p T, like @c INT64_MIN / @c -1.
+   */
+  constexpr lazy_fraction(const T& numerator = ZERO, const T& denominator = ONE);
+  constexpr lazy_fraction(const fraction_type& value) noexcept;
+
+  /// Unreduced numerator
+  constexpr const T& getNumerator() const noexcept;
+  /// Unreduced denominator. Always positive
+  constexpr const T& getDenominator() const noexcept;
+
+  /// Reduces numerator and denominator now
+  constexpr void reduce();
+  constexpr fraction_type reduced() const;
+
+  // Conversion operators
+  constexpr operator fraction_type() const;
+
+  template <class D,
+            class CHECK_D = typename std::enable_if<std::is_arithmetic<D>::value && !is_fraction<D>::value>::type>
+  constexpr explicit operator D() const;
+
+  // Arithmetic operators
+  constexpr lazy_fraction<T, CHECK_T>& operator+=(const lazy_fraction<T, CHECK_T>& rhs);
+  constexpr lazy_fraction<T, CHECK_T>& operator-=(const lazy_fraction<T, CHECK_T>& rhs);
+  constexpr lazy_fraction<T, CHECK_T>& operator*=(const lazy_fraction<T, CHECK_T>& rhs);
+  constexpr lazy_fraction<T, CHECK_T>& operator/=(const lazy_fraction<T, CHECK_T>& rhs);
+
+  friend constexpr lazy_fraction<T, CHECK_T> operator+(lazy_fraction<T, CHECK_T> lhs,
+                                                       const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs += rhs;
+  }
+  friend constexpr lazy_fraction<T, CHECK_T> operator-(lazy_fraction<T, CHECK_T> lhs,
+                                                       const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs -= rhs;
+  }
+  friend constexpr lazy_fraction<T, CHECK_T> operator*(lazy_fraction<T, CHECK_T> lhs,
+                                                       const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs *= rhs;
+  }
+  friend constexpr lazy_fraction<T, CHECK_T> operator/(lazy_fraction<T, CHECK_T> lhs,
+                                                       const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs /= rhs;
+  }
+
+  // Relational operators
+  friend constexpr bool operator==(const lazy_fraction<T, CHECK_T>& lhs, const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs.reduced() == rhs.reduced();
+  }
+  friend constexpr bool operator!=(const lazy_fraction<T, CHECK_T>& lhs, const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs.reduced() != rhs.reduced();
+  }
+  friend constexpr bool operator<(const lazy_fraction<T, CHECK_T>& lhs, const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs.reduced() < rhs.reduced();
+  }
+  friend constexpr bool operator>(const lazy_fraction<T, CHECK_T>& lhs, const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs.reduced() > rhs.reduced();
+  }
+  friend constexpr bool operator<=(const lazy_fraction<T, CHECK_T>& lhs, const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs.reduced() <= rhs.reduced();
+  }
+  friend constexpr bool operator>=(const lazy_fraction<T, CHECK_T>& lhs, const lazy_fraction<T, CHECK_T>& rhs) {
+    return lhs.reduced() >= rhs.reduced();
+  }
+
+  // Stream operators
+  template <class charT, class traits>
+  friend std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, traits>& ostream,
+                                                       const lazy_fraction<T, CHECK_T>& value) {
+    return ostream << value.reduced();
+  }
+
+ private:
+  static constexpr bool isNegative(const T& value) noexcept;
+
+  constexpr void add(const lazy_fraction<T, CHECK_T>& rhs, bool subtract);
+
+  /*!
+   * @brief Stores a result given in double width
+   *
+   * The result is only reduced when it wouldn't fit into @p T otherwise.
+   *
+   * @throws std::invalid_argument when @p denominator is 0.
+   * @throws std::overflow_error when even the reduced result doesn't fit into @p T.
+   */
+  constexpr void store(bool negative, wide_type numerator, wide_type denominator);
+};
+
+/*!
+ * @brief Transparent hash for @c fraction and @c lazy_fraction
+ *
+ * Unreduced values hash like their reduced fraction, so containers of fractions can be searched with lazy fractions
+ * without converting them first. Use it together with @c fraction_equal_to.
+ */
+template <class T = std::int64_t, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+struct fraction_hash {
+  typedef void is_transparent;
+
+  constexpr std::size_t operator()(const fraction<T, CHECK_T>& value) const noexcept;
+  constexpr std::size_t operator()(const lazy_fraction<T, CHECK_T>& value) const noexcept;
+};
+
+/// Transparent equality for @c fraction and @c lazy_fraction
+template <class T = std::int64_t, class CHECK_T = typename std::enable_if<std::is_integral<T>::value>::type>
+struct fraction_equal_to {
+  typedef void is_transparent;
+
+  constexpr bool operator()(const fraction<T, CHECK_T>& lhs, const fraction<T, CHECK_T>& rhs) const noexcept;
+  constexpr bool operator()(const fraction<T, CHECK_T>& lhs, const lazy_fraction<T, CHECK_T>& rhs) const noexcept;
+  constexpr bool operator()(const lazy_fraction<T, CHECK_T>& lhs, const fraction<T, CHECK_T>& rhs) const noexcept;
+  constexpr bool operator()(const lazy_fraction<T, CHECK_T>& lhs,
+                            const lazy_fraction<T, CHECK_T>& rhs) const noexcept;
+};
+
+namespace std {
+/// Hashes lazy fractions like their reduced @c fraction
+template <class T, class CHECK_T>
+struct hash<lazy_fraction<T, CHECK_T>> {
+  constexpr size_t operator()(const lazy_fraction<T, CHECK_T>& value) const noexcept;
+};
+}  // namespace std
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Implementation
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T, class CHECK_T>
+inline constexpr lazy_fraction<T, CHECK_T>::lazy_fraction(const T& numerator, const T& denominator)
+    : numerator{numerator}, denominator{denominator} {
+  if (denominator == ZERO) throw std::invalid_argument("The denominator must not be 0!");
+
+  // Negating the minimum overflows, so the sign is moved through the double width path that reduces when needed
+  if (isNegative(denominator))
+    store(!isNegative(numerator), wide_type{details::magnitude(numerator)}, wide_type{details::magnitude(denominator)});
+}
+
+template <class T, class CHECK_T>
+inline constexpr lazy_fraction<T, CHECK_T>::lazy_fraction(const fraction_type& value) noexcept
+    : numerator{value.getNumerator()}, denominator{value.getDenominator()} {}
+
+template <class T, class CHECK_T>
+inline constexpr const T& lazy_fraction<T, CHECK_T>::getNumerator() const noexcept {
+  return numerator;
+}
+
+template <class T, class CHECK_T>
+inline constexpr const T& lazy_fraction<T, CHECK_T>::getDenominator() const noexcept {
+  return denominator;
+}
+
+template <class T, class CHECK_T>
+inline constexpr void lazy_fraction<T, CHECK_T>::reduce() {
+  *this = reduced();
+}
+
+template <class T, class CHECK_T>
+inline constexpr typename lazy_fraction<T, CHECK_T>::fraction_type lazy_fraction<T, CHECK_T>::reduced() const {
+  return fraction_type{numerator, denominator};
+}
+
+template <class T, class CHECK_T>
+inline constexpr lazy_fraction<T, CHECK_T>::operator fraction_type() const {
+  return reduced();
+}
+
+template <class T, class CHECK_T>
+template <class D, class CHECK_D>
+inline constexpr lazy_fraction<T, CHECK_T>::operator D() const {
+  return static_cast<D>(reduced());
+}
+
+template <class T, class CHECK_T>
+inline constexpr lazy_fraction<T, CHECK_T>& lazy_fraction<T, CHECK_T>::operator+=(
+    const lazy_fraction<T, CHECK_T>& rhs) {
+  add(rhs, false);
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline constexpr lazy_fraction<T, CHECK_T>& lazy_fraction<T, CHECK_T>::operator-=(
+    const lazy_fraction<T, CHECK_T>& rhs) {
+  add(rhs, true);
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline constexpr lazy_fraction<T, CHECK_T>& lazy_fraction<T, CHECK_T>::operator*=(
+    const lazy_fraction<T, CHECK_T>& rhs) {
+  store(isNegative(numerator) != isNegative(rhs.numerator),
+        details::multiply(details::magnitude(numerator), details::magnitude(rhs.numerator)),
+        details::multiply(details::magnitude(denominator), details::magnitude(rhs.denominator)));
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline constexpr lazy_fraction<T, CHECK_T>& lazy_fraction<T, CHECK_T>::operator/=(
+    const lazy_fraction<T, CHECK_T>& rhs) {
+  store(isNegative(numerator) != isNegative(rhs.numerator),
+        details::multiply(details::magnitude(numerator), details::magnitude(rhs.denominator)),
+        details::multiply(details::magnitude(denominator), details::magnitude(rhs.numerator)));
+
+  return *this;
+}
+
+template <class T, class CHECK_T>
+inline constexpr bool lazy_fraction<T, CHECK_T>::isNegative(const T& value) noexcept {
+  if constexpr (std::is_signed<T>::value)
+    return value < ZERO;
+  else
+    return false;
+}
+
+template <class T, class CHECK_T>
+inline constexpr void lazy_fraction<T, CHECK_T>::add(const lazy_fraction<T, CHECK_T>& rhs, bool subtract) {
+  const bool lhsNegative{isNegative(numerator)};
+  const bool rhsNegative{isNegative(rhs.numerator) != subtract};
+
+  const unsigned_type lhsDenominator{details::magnitude(denominator)};
+  const unsigned_type rhsDenominator{details::magnitude(rhs.denominator)};
+
+  const wide_type lhsPart{details::multiply(details::magnitude(numerator), rhsDenominator)};
+  const wide_type rhsPart{details::multiply(details::magnitude(rhs.numerator), lhsDenominator)};
+  const wide_type commonDenominator{details::multiply(lhsDenominator, rhsDenominator)};
+
+  if (lhsNegative == rhsNegative) {
+    const wide_type sum{static_cast<wide_type>(lhsPart + rhsPart)};
+
+    // Can only happen for unsigned 64 bit types
+    if (sum < lhsPart) throw std::overflow_error("The result does not fit into the fraction!");
+
+    store(lhsNegative, sum, commonDenominator);
+  } else if (lhsPart >= rhsPart) {
+    store(lhsNegative, static_cast<wide_type>(lhsPart - rhsPart), commonDenominator);
+  } else if constexpr (std::is_unsigned<T>::value) {
+    // Keep the wrap around semantics of fraction
+    *this = subtract ? reduced() - rhs.reduced() : reduced() + rhs.reduced();
+  } else {
+    store(rhsNegative, static_cast<wide_type>(rhsPart - lhsPart), commonDenominator);
+  }
+}
+
+template <class T, class CHECK_T>
+inline constexpr void lazy_fraction<T, CHECK_T>::store(bool negative, wide_type numerator, wide_type denominator) {
+  constexpr wide_type W_ZERO{0};
+  constexpr wide_type MAX_POSITIVE{static_cast<unsigned_type>(std::numeric_limits<T>::max())};
+  constexpr wide_type MAX_NEGATIVE{std::is_signed<T>::value ? static_cast<wide_type>(MAX_POSITIVE + wide_type{1})
+                                                            : W_ZERO};
+
+  if (denominator == W_ZERO) throw std::invalid_argument("The denominator must not be 0!");
+
+  if (numerator == W_ZERO) {
+    this->numerator = ZERO;
+    this->denominator = ONE;
+
+    return;
+  }
+
+  // Only reduce if the result doesn't fit as it is
+  if ((denominator > MAX_POSITIVE) || (numerator > (negative ? MAX_NEGATIVE : MAX_POSITIVE))) {
+    const wide_type gcd{details::gcd(numerator, denominator)};
+
+    numerator = static_cast<wide_type>(numerator / gcd);
+    denominator = static_cast<wide_type>(denominator / gcd);
+
+    if ((denominator > MAX_POSITIVE) || (numerator > (negative ? MAX_NEGATIVE : MAX_POSITIVE)))
+      throw std::overflow_error("The result does not fit into the fraction!");
+  }
+
+  const unsigned_type narrowNumerator{static_cast<unsigned_type>(numerator)};
+
+  this->numerator = static_cast<T>(negative ? static_cast<unsigned_type>(unsigned_type{0} - narrowNumerator)
+                                            : narrowNumerator);
+  this->denominator = static_cast<T>(static_cast<unsigned_type>(denominator));
+}
+
+template <class T, class CHECK_T>
+inline constexpr std::size_t fraction_hash<T, CHECK_T>::operator()(const fraction<T, CHECK_T>& value) const noexcept {
+  return details::hashFraction(value.getNumerator(), value.getDenominator());
+}
+
+template <class T, class CHECK_T>
+inline constexpr std::size_t fraction_hash<T, CHECK_T>::operator()(
+    const lazy_fraction<T, CHECK_T>& value) const noexcept {
+  // Integers are reduced already. Everything else needs the gcd to find the reduced form
+  if (value.getDenominator() == T{1}) return details::hashFraction(value.getNumerator(), value.getDenominator());
+
+  // The denominator is positive, so reducing can't throw
+  return (*this)(value.reduced());
+}
+
+template <class T, class CHECK_T>
+inline constexpr bool fraction_equal_to<T, CHECK_T>::operator()(const fraction<T, CHECK_T>& lhs,
+                                                                const fraction<T, CHECK_T>& rhs) const noexcept {
+  return lhs == rhs;
+}
+
+template <class T, class CHECK_T>
+inline constexpr bool fraction_equal_to<T, CHECK_T>::operator()(const fraction<T, CHECK_T>& lhs,
+                                                                const lazy_fraction<T, CHECK_T>& rhs) const noexcept {
+  return lhs == rhs.reduced();
+}
+
+template <class T, class CHECK_T>
+inline constexpr bool fraction_equal_to<T, CHECK_T>::operator()(const lazy_fraction<T, CHECK_T>& lhs,
+                                                                const fraction<T, CHECK_T>& rhs) const noexcept {
+  return lhs.reduced() == rhs;
+}
+
+template <class T, class CHECK_T>
+inline constexpr bool fraction_equal_to<T, CHECK_T>::operator()(const lazy_fraction<T, CHECK_T>& lhs,
+                                                                const lazy_fraction<T, CHECK_T>& rhs) const noexcept {
+  return lhs == rhs;
+}
+
+namespace std {
+template <class T, class CHECK_T>
+constexpr size_t hash<lazy_fraction<T, CHECK_T>>::operator()(const lazy_fraction<T, CHECK_T>& value) const noexcept {
+  return fraction_hash<T, CHECK_T>{}(value);
+}
+}  // namespace std
+
+#endif  // !FRACTION_LAZY_FRACTION_HPP_
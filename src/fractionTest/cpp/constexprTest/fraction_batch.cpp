@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+
+#define TEST_CASE_NAME ConstexprTest_fraction_batch
+
+TEST(TEST_CASE_NAME, kernels) {
+  constexpr fraction_t lhs[]{{1, 2}, {-2, 3}, {5, 6}, {7}};
+  constexpr fraction_t rhs[]{{3, 4}, {3, 8}, {-6, 5}, {0}};
+
+  constexpr fraction_t val1Expected{lhs[0] + lhs[1] + lhs[2] + lhs[3]};
+  constexpr fraction_t val2Expected{lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2] + lhs[3] * rhs[3]};
+  constexpr fraction_t val3Expected{};
+  constexpr fraction_t val4Expected{lhs[3]};
+
+  constexpr fraction_t val1Actual{fractionSum(lhs, 4)};
+  constexpr fraction_t val2Actual{fractionDot(lhs, rhs, 4)};
+  constexpr fraction_t val3Actual{fractionSum(lhs, 0)};
+  constexpr fraction_t val4Actual{fractionSum(lhs + 3, 1)};
+
+  EXPECT_EQ(val1Expected, val1Actual);
+  EXPECT_NE(val1Expected, val2Actual);
+  EXPECT_NE(val1Expected, val3Actual);
+  EXPECT_NE(val1Expected, val4Actual);
+  EXPECT_NE(val2Expected, val1Actual);
+  EXPECT_EQ(val2Expected, val2Actual);
+  EXPECT_NE(val2Expected, val3Actual);
+  EXPECT_NE(val2Expected, val4Actual);
+  EXPECT_NE(val3Expected, val1Actual);
+  EXPECT_NE(val3Expected, val2Actual);
+  EXPECT_EQ(val3Expected, val3Actual);
+  EXPECT_NE(val3Expected, val4Actual);
+  EXPECT_NE(val4Expected, val1Actual);
+  EXPECT_NE(val4Expected, val2Actual);
+  EXPECT_NE(val4Expected, val3Actual);
+  EXPECT_EQ(val4Expected, val4Actual);
+
+  fraction_t y[]{{1, 4}, {-1, 3}, {0}, {2}};
+
+  fractionAxpy(fraction_t{3, 2}, lhs, y, 4);
+
+  EXPECT_EQ(fraction_t(1), y[0]);
+  EXPECT_EQ(fraction_t(-4, 3), y[1]);
+  EXPECT_EQ(fraction_t(5, 4), y[2]);
+  EXPECT_EQ(fraction_t(25, 2), y[3]);
+}
+
+TEST(TEST_CASE_NAME, harmonicSeries) {
+  std::vector<fraction_t> values;
+  fraction_t expected{};
+
+  // The unreduced denominators exceed 64 bits quickly, while the reduced ones still fit
+  for (std::int64_t i = 1; i <= 40; ++i) {
+    values.emplace_back(1, i);
+    expected += values.back();
+  }
+
+  EXPECT_EQ(expected, fractionSum(values.data(), values.size()));
+  EXPECT_EQ(expected, fractionDot(values.data(), std::vector<fraction_t>(values.size(), fraction_t{1}).data(),
+                                  values.size()));
+}
+
+TEST(TEST_CASE_NAME, reductionOnOverflow) {
+  constexpr std::int32_t prime1{std::numeric_limits<std::int32_t>::max()};
+  constexpr std::int32_t prime2{2147483629};
+  constexpr std::int32_t prime3{2147483587};
+
+  // The denominator of the sum of the first two values only fits into the double width. Cancelling the second value
+  // keeps it unreduced, so the third value only fits after reducing the running sum
+  const fraction32_t values[]{{1, prime1}, {1, prime2}, {-1, prime2}, {1, prime3}, {-1, prime3}};
+
+  EXPECT_EQ(fraction32_t(1, prime1), fractionSum(values, 5));
+}
+
+TEST(TEST_CASE_NAME, overflowException) {
+  constexpr std::int32_t prime1{std::numeric_limits<std::int32_t>::max()};
+  constexpr std::int32_t prime2{2147483629};
+  constexpr std::int32_t prime3{2147483587};
+  constexpr std::int64_t max{std::numeric_limits<std::int64_t>::max()};
+  constexpr std::int64_t min{std::numeric_limits<std::int64_t>::min()};
+
+  const fraction32_t values[]{{1, prime1}, {1, prime2}, {1, prime3}};
+  const fraction_t maxValues[]{{max}, {1}, {-1}};
+  const fraction_t minValues[]{{min}, {-1}};
+  fraction_t y[]{{max}};
+
+  // Result doesn't fit
+  EXPECT_THROW(fractionSum(values, 2), std::overflow_error);
+  EXPECT_THROW(fractionSum(maxValues, 2), std::overflow_error);
+  EXPECT_THROW(fractionSum(minValues, 2), std::overflow_error);
+  EXPECT_THROW(fractionDot(maxValues, maxValues, 2), std::overflow_error);
+  EXPECT_THROW(fractionAxpy(fraction_t{1}, maxValues + 1, y, 1), std::overflow_error);
+  // Even the reduced intermediate sum needs more than double the width
+  EXPECT_THROW(fractionSum(values, 3), std::overflow_error);
+
+  // Intermediate results may exceed the range, as long as the result fits
+  EXPECT_EQ(fraction_t(max), fractionSum(maxValues, 3));
+  EXPECT_EQ(fraction_t(max), fractionDot(maxValues, std::vector<fraction_t>{{2}, {0}, {max}}.data(), 3));
+  EXPECT_EQ(fraction_t(min), fractionSum(std::vector<fraction_t>{{min}, {-1}, {1}}.data(), 3));
+}
+
+TEST(TEST_CASE_NAME, parallelReduction) {
+  constexpr std::int64_t count{100'000};
+
+  std::vector<fraction_t> summands;
+  std::vector<fraction_t> factors;
+
+  // Telescoping series, so the results are known
+  for (std::int64_t i = 1; i <= count; ++i) {
+    summands.emplace_back(1, i * (i + 1));
+    factors.emplace_back(i + 1, i);
+  }
+
+  const fraction_t sumExpected{count, count + 1};
+  const fraction_t productExpected{count + 1};
+
+  for (unsigned int threads : {1u, 2u, 3u, 8u, 0u}) {
+    EXPECT_EQ(sumExpected, fractionSum(summands.data(), summands.size(), threads)) << "Threads: " << threads;
+    EXPECT_EQ(productExpected, fractionProduct(factors.data(), factors.size(), threads)) << "Threads: " << threads;
+  }
+
+  EXPECT_EQ(productExpected, fractionProduct(factors.data(), factors.size()));
+  EXPECT_EQ(fraction_t(1), fractionProduct(factors.data(), 0, 4));
+  EXPECT_EQ(fraction_t(), fractionSum(summands.data(), 0, 4));
+}
+
+TEST(TEST_CASE_NAME, parallelOverflowException) {
+  std::vector<fraction_t> values(50'000, fraction_t{1});
+
+  // Lands in a leaf summed up on another thread
+  values[1'000] = fraction_t{std::numeric_limits<std::int64_t>::max()};
+
+  EXPECT_THROW(fractionSum(values.data(), values.size(), 4), std::overflow_error);
+  EXPECT_THROW(fractionProduct(std::vector<fraction_t>(50'000, fraction_t{2}).data(), 50'000, 4),
+               std::overflow_error);
+}
@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+
+#define TEST_CASE_NAME ConstexprTest_fraction_bigint
+
+TEST(TEST_CASE_NAME, zeroExcpetion) {
+  EXPECT_THROW(fraction_bigint_t(1, 0), std::invalid_argument);
+  EXPECT_THROW(fraction_bigint_t(1) / fraction_bigint_t(0), std::invalid_argument);
+  EXPECT_THROW(bigint(1) / bigint(0), std::invalid_argument);
+}
+
+TEST(TEST_CASE_NAME, strings) {
+  const bigint val1{std::string{"123456789012345678901234567890"}};
+  const bigint val2{std::string{"-98765432109876543210"}};
+  const bigint val3{std::string{"-0"}};
+
+  EXPECT_EQ("123456789012345678901234567890", val1.toString());
+  EXPECT_EQ("-98765432109876543210", val2.toString());
+  EXPECT_EQ("0", val3.toString());
+  EXPECT_EQ("1000000000000000000", bigint{1'000'000'000'000'000'000}.toString());
+  EXPECT_EQ("-9223372036854775808", bigint{std::numeric_limits<std::int64_t>::min()}.toString());
+
+  EXPECT_THROW(bigint{std::string{""}}, std::invalid_argument);
+  EXPECT_THROW(bigint{std::string{"-"}}, std::invalid_argument);
+  EXPECT_THROW(bigint{std::string{"12a"}}, std::invalid_argument);
+}
+
+TEST(TEST_CASE_NAME, arithmetic) {
+  const bigint val1{std::string{"123456789012345678901234567890"}};
+  const bigint val2{std::string{"-98765432109876543210"}};
+
+  EXPECT_EQ(bigint{std::string{"123456788913580246791358024680"}}, val1 + val2);
+  EXPECT_EQ(bigint{std::string{"123456789111111111011111111100"}}, val1 - val2);
+  EXPECT_EQ(bigint{std::string{"-12193263113702179522496570642237463801111263526900"}}, val1 * val2);
+  EXPECT_EQ(bigint{-1249999988}, val1 / val2);
+  EXPECT_EQ(bigint{std::string{"60185185207253086410"}}, val1 % val2);
+  EXPECT_EQ(bigint{90}, bigint::gcd(val1, val2));
+
+  // Only values above 128 bits allocate
+  const bigint inlineMax{(bigint{1} * bigint{std::numeric_limits<std::uint64_t>::max()} *
+                          bigint{std::numeric_limits<std::uint64_t>::max()})};
+
+  EXPECT_FALSE(val1.isAllocated());
+  EXPECT_FALSE(inlineMax.isAllocated());
+  EXPECT_TRUE((val1 * val2).isAllocated());
+}
+
+TEST(TEST_CASE_NAME, conversion) {
+  constexpr std::int64_t max{std::numeric_limits<std::int64_t>::max()};
+  constexpr std::int64_t min{std::numeric_limits<std::int64_t>::min()};
+
+  EXPECT_TRUE(bigint{min}.fits<std::int64_t>());
+  EXPECT_FALSE(bigint{min}.fits<std::uint64_t>());
+  EXPECT_FALSE((bigint{min} - bigint{1}).fits<std::int64_t>());
+  EXPECT_FALSE((bigint{max} + bigint{1}).fits<std::int64_t>());
+  EXPECT_TRUE((bigint{max} + bigint{1}).fits<std::uint64_t>());
+
+  EXPECT_EQ(min, static_cast<std::int64_t>(bigint{min}));
+  EXPECT_EQ(max, static_cast<std::int64_t>(bigint{max}));
+  EXPECT_EQ(-1, static_cast<std::int8_t>(bigint{-1}));
+  EXPECT_THROW(static_cast<std::int8_t>(bigint{128}), std::overflow_error);
+
+  const fraction_bigint_t val{fraction_t{max, 3}};
+
+  EXPECT_EQ(fraction_t(max, 3), val.toFraction<std::int64_t>());
+  EXPECT_THROW((val * 6).toFraction<std::int64_t>(), std::overflow_error);
+}
+
+TEST(TEST_CASE_NAME, fractionArithmetic) {
+  constexpr std::int64_t max{std::numeric_limits<std::int64_t>::max()};
+
+  const fraction_bigint_t val1{1, 3};
+  const fraction_bigint_t val2{-2, 6};
+  const fraction_bigint_t val3{max, 2};
+
+  EXPECT_EQ(fraction_bigint_t(-1, 3), val2);
+  EXPECT_EQ(fraction_bigint_t(0), val1 + val2);
+  EXPECT_EQ(fraction_bigint_t(2, 3), val1 - val2);
+  EXPECT_EQ(fraction_bigint_t(-1, 9), val1 * val2);
+  EXPECT_EQ(fraction_bigint_t(-1), val1 / val2);
+  EXPECT_EQ(fraction_bigint_t(4, 3), val1 + 1);
+  EXPECT_EQ(fraction_bigint_t(2, 3), 1 - val1);
+  EXPECT_EQ(fraction_bigint_t(1), 3 * val1);
+  EXPECT_EQ(fraction_bigint_t(1, 6), val1 / 2);
+  EXPECT_EQ(fraction_bigint_t(7, 6), val1 + fraction_t(5, 6));
+  EXPECT_EQ(fraction_bigint_t(-1, 3), -val1);
+
+  // The results of 64 bit fractions that would overflow
+  const fraction_bigint_t square{val3 * val3};
+
+  EXPECT_EQ(bigint{max} * bigint{max}, square.getNumerator());
+  EXPECT_EQ(bigint{4}, square.getDenominator());
+  EXPECT_EQ(val3, square / val3);
+  EXPECT_EQ((fraction_bigint_t{bigint{max} + bigint{2}, bigint{2}}), val3 + 1);
+
+  fraction_bigint_t val4{val1};
+
+  EXPECT_EQ(fraction_bigint_t(4, 3), ++val4);
+  EXPECT_EQ(fraction_bigint_t(4, 3), val4--);
+  EXPECT_EQ(fraction_bigint_t(1, 3), val4);
+}
+
+TEST(TEST_CASE_NAME, comparison) {
+  const fraction_bigint_t val1{1, 3};
+  const fraction_bigint_t val2{-2, 6};
+  const fraction_bigint_t val3{bigint{std::string{"123456789012345678901234567890"}}, 7};
+
+  EXPECT_TRUE(val2 < val1);
+  EXPECT_TRUE(val1 > val2);
+  EXPECT_TRUE(val1 <= val1);
+  EXPECT_TRUE(val1 >= val2);
+  EXPECT_TRUE(val1 != val2);
+  EXPECT_TRUE(val1 < val3);
+  EXPECT_TRUE(val1 < 1);
+  EXPECT_TRUE(0 > val2);
+  EXPECT_TRUE(fraction_bigint_t(6, 3) == 2);
+  EXPECT_TRUE(val3 > std::numeric_limits<std::int64_t>::max());
+  EXPECT_FALSE(val1 == val2);
+}
+
+TEST(TEST_CASE_NAME, hash) {
+  const std::unordered_set<fraction_bigint_t> values{{1, 3}, {2, 6}, {-1, 3}, {1, 4}};
+
+  EXPECT_EQ(3U, values.size());
+  EXPECT_EQ(std::hash<fraction_bigint_t>{}(fraction_bigint_t{1, 3}), std::hash<fraction_bigint_t>{}({3, 9}));
+}
+
+TEST(TEST_CASE_NAME, ostream) {
+  std::stringstream stream;
+  std::wstringstream wstream;
+
+  stream << fraction_bigint_t{bigint{std::string{"-123456789012345678901234567890"}}, 4};
+  wstream << fraction_bigint_t{1, 3};
+
+  EXPECT_EQ("-61728394506172839450617283945/2", stream.str());
+  EXPECT_EQ(L"1/3", wstream.str());
+}
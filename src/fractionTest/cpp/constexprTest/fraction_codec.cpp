@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+
+#define TEST_CASE_NAME ConstexprTest_fraction_codec
+
+namespace {
+constexpr std::size_t encodedSize(const fraction_t& value) {
+  unsigned char buffer[fraction_codec_t::maxEncodedSize]{};
+
+  return static_cast<std::size_t>(fraction_codec_t::encode(value, buffer) - buffer);
+}
+
+constexpr fraction_t roundTrip(const fraction_t& value) {
+  unsigned char buffer[fraction_codec_t::maxEncodedSize]{};
+  fraction_t result{};
+
+  fraction_codec_t::decode(buffer, fraction_codec_t::encode(value, buffer), result);
+
+  return result;
+}
+}  // namespace
+
+TEST(TEST_CASE_NAME, encodedSize) {
+  constexpr std::int64_t max{std::numeric_limits<std::int64_t>::max()};
+  constexpr std::int64_t min{std::numeric_limits<std::int64_t>::min()};
+
+  // Small integers take a single byte and small fractions two
+  EXPECT_EQ(1U, encodedSize(fraction_t{0}));
+  EXPECT_EQ(1U, encodedSize(fraction_t{-1}));
+  EXPECT_EQ(1U, encodedSize(fraction_t{31}));
+  EXPECT_EQ(2U, encodedSize(fraction_t{32}));
+  EXPECT_EQ(2U, encodedSize(fraction_t{1, 2}));
+  EXPECT_EQ(2U, encodedSize(fraction_t{-3, 7}));
+  EXPECT_EQ(3U, encodedSize(fraction_t{-3, 700}));
+  EXPECT_EQ(10U, encodedSize(fraction_t{min}));
+  EXPECT_EQ(19U, encodedSize(fraction_t{min, max}));
+}
+
+TEST(TEST_CASE_NAME, roundTrip) {
+  constexpr std::int64_t max{std::numeric_limits<std::int64_t>::max()};
+  constexpr std::int64_t min{std::numeric_limits<std::int64_t>::min()};
+
+  constexpr fraction_t val1{-3, 7};
+  constexpr fraction_t val2{max, 2};
+  constexpr fraction_t val3{min, max};
+  constexpr fraction_t val4{0};
+
+  constexpr fraction_t val1Actual{roundTrip(val1)};
+  constexpr fraction_t val2Actual{roundTrip(val2)};
+  constexpr fraction_t val3Actual{roundTrip(val3)};
+  constexpr fraction_t val4Actual{roundTrip(val4)};
+
+  EXPECT_EQ(val1, val1Actual);
+  EXPECT_NE(val1, val2Actual);
+  EXPECT_NE(val1, val3Actual);
+  EXPECT_NE(val1, val4Actual);
+  EXPECT_NE(val2, val1Actual);
+  EXPECT_EQ(val2, val2Actual);
+  EXPECT_NE(val2, val3Actual);
+  EXPECT_NE(val2, val4Actual);
+  EXPECT_NE(val3, val1Actual);
+  EXPECT_NE(val3, val2Actual);
+  EXPECT_EQ(val3, val3Actual);
+  EXPECT_NE(val3, val4Actual);
+  EXPECT_NE(val4, val1Actual);
+  EXPECT_NE(val4, val2Actual);
+  EXPECT_NE(val4, val3Actual);
+  EXPECT_EQ(val4, val4Actual);
+}
+
+TEST(TEST_CASE_NAME, block) {
+  const std::vector<fraction_t> values{{1, 2}, {-3, 7}, {5}, {std::numeric_limits<std::int64_t>::min()}};
+  std::vector<unsigned char> buffer(fraction_codec_t::maxBlockSize(values.size()));
+
+  const unsigned char* const end{fraction_codec_t::encodeBlock(values.data(), values.size(), buffer.data())};
+  // Count, size, 2 + 2 + 1 + 10 bytes of fractions and the checksum
+  EXPECT_EQ(21, end - buffer.data());
+
+  std::vector<fraction_t> actual{fraction_t{1}};
+
+  EXPECT_EQ(end, fraction_codec_t::decodeBlock(buffer.data(), end, actual));
+  EXPECT_EQ(fraction_t{1}, actual[0]);
+  EXPECT_EQ(values, std::vector<fraction_t>(actual.begin() + 1, actual.end()));
+}
+
+TEST(TEST_CASE_NAME, corruptData) {
+  const std::vector<fraction_t> values{{1, 2}, {-3, 7}, {5}};
+  std::vector<unsigned char> buffer(fraction_codec_t::maxBlockSize(values.size()));
+  unsigned char* const end{fraction_codec_t::encodeBlock(values.data(), values.size(), buffer.data())};
+  std::vector<fraction_t> actual;
+
+  EXPECT_THROW(fraction_codec_t::decodeBlock(buffer.data(), end - 1, actual), std::invalid_argument);
+
+  buffer[3] ^= 0x10;
+
+  EXPECT_THROW(fraction_codec_t::decodeBlock(buffer.data(), end, actual), std::invalid_argument);
+  EXPECT_TRUE(actual.empty());
+
+  fraction_t value{};
+  // Denominator 0, a numerator of 0 with a denominator, 2/4 and -2/4, and a truncated value
+  const unsigned char zeroDenominator[]{0x02, 0x00};
+  const unsigned char zeroNumerator[]{0x00, 0x02};
+  const unsigned char unreduced[]{0x08, 0x04};
+  const unsigned char negativeUnreduced[]{0x06, 0x04};
+  const unsigned char truncated[]{0x84};
+
+  EXPECT_THROW(fraction_codec_t::decode(zeroDenominator, zeroDenominator + 2, value), std::invalid_argument);
+  EXPECT_THROW(fraction_codec_t::decode(zeroNumerator, zeroNumerator + 2, value), std::invalid_argument);
+  EXPECT_THROW(fraction_codec_t::decode(unreduced, unreduced + 2, value), std::invalid_argument);
+  EXPECT_THROW(fraction_codec_t::decode(negativeUnreduced, negativeUnreduced + 2, value), std::invalid_argument);
+  EXPECT_THROW(fraction_codec_t::decode(unreduced, unreduced + 2, &value, 1), std::invalid_argument);
+  EXPECT_THROW(fraction_codec_t::decode(truncated, truncated + 1, value), std::invalid_argument);
+
+  // A block with a valid checksum still can't carry an unreduced fraction
+  unsigned char block[]{0x01, 0x02, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00};
+  const std::uint32_t checksum{details::crc32(block, 4)};
+
+  for (std::size_t i = 0; i < 4; ++i) block[4 + i] = static_cast<unsigned char>(checksum >> (8 * i));
+
+  EXPECT_THROW(fraction_codec_t::decodeBlock(block, block + sizeof(block), actual), std::invalid_argument);
+  EXPECT_TRUE(actual.empty());
+}
+
+TEST(TEST_CASE_NAME, overflowException) {
+  unsigned char buffer[fraction_codec_t::maxEncodedSize]{};
+  fraction32_t value{};
+
+  // Written with 64 bits, but too large for 32 bits
+  const unsigned char* end{fraction_codec_t::encode(fraction_t{std::int64_t{1} << 40, 3}, buffer)};
+  EXPECT_THROW(fraction_codec32_t::decode(buffer, end, value), std::overflow_error);
+
+  end = fraction_codec_t::encode(fraction_t{1, std::int64_t{1} << 40}, buffer);
+  EXPECT_THROW(fraction_codec32_t::decode(buffer, end, value), std::overflow_error);
+
+  // Values that do fit can be read with a smaller type
+  end = fraction_codec_t::encode(fraction_t{-3, 7}, buffer);
+  fraction_codec32_t::decode(buffer, end, value);
+  EXPECT_EQ(fraction32_t(-3, 7), value);
+}
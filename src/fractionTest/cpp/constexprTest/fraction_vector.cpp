@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+
+#define TEST_CASE_NAME ConstexprTest_fraction_vector
+
+TEST(TEST_CASE_NAME, columns) {
+  const fraction_vector_t values{{1, 2}, {-6, 4}, {5}, {0, 7}};
+
+  ASSERT_EQ(4u, values.size());
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(values.numeratorData()) % fraction_vector_t::alignment);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(values.denominatorData()) % fraction_vector_t::alignment);
+
+  const std::int64_t numeratorsExpected[]{1, -3, 5, 0};
+  const std::int64_t denominatorsExpected[]{2, 2, 1, 1};
+
+  EXPECT_TRUE(std::equal(numeratorsExpected, numeratorsExpected + 4, values.numeratorData()));
+  EXPECT_TRUE(std::equal(denominatorsExpected, denominatorsExpected + 4, values.denominatorData()));
+}
+
+TEST(TEST_CASE_NAME, columnConstructor) {
+  const std::int32_t numerators[]{4, -9, 0, 10, 21};
+  const std::int32_t denominators[]{8, -3, -5, 4, 14};
+
+  const fraction_vector32_t expected{{1, 2}, {3}, {0}, {5, 2}, {3, 2}};
+
+  EXPECT_EQ(expected, fraction_vector32_t(numerators, denominators, 5));
+  EXPECT_THROW(fraction_vector32_t(numerators, numerators + 2, 3), std::invalid_argument);
+}
+
+TEST(TEST_CASE_NAME, proxyReferences) {
+  fraction_vector_t values(3, fraction_t{1, 3});
+
+  values[0] = fraction_t{2, 4};
+  values[1] += fraction_t{1, 6};
+  values[2] = values[0];
+  values[2] *= 4;
+
+  EXPECT_EQ(fraction_t(1, 2), values[0]);
+  EXPECT_EQ(values[0], values[1]);
+  EXPECT_EQ(2, values[2]);
+  EXPECT_LT(values[0], values[2]);
+  EXPECT_EQ(fraction_t(5, 2), values[0] + values[2]);
+  EXPECT_EQ(1, values[1].getNumerator());
+  EXPECT_EQ(2, values[1].getDenominator());
+
+  const fraction_vector_t& constValues{values};
+
+  EXPECT_EQ(fraction_t(2), constValues[2]);
+  EXPECT_THROW(values.at(3), std::out_of_range);
+  EXPECT_THROW(constValues.at(3), std::out_of_range);
+
+  std::stringstream stream;
+
+  stream << values[1];
+
+  EXPECT_EQ("1/2", stream.str());
+}
+
+TEST(TEST_CASE_NAME, iterators) {
+  fraction_vector_t values{{3, 4}, {-1, 2}, {7}, {1, 3}, {0}};
+  const fraction_vector_t expected{{-1, 2}, {0}, {1, 3}, {3, 4}, {7}};
+
+  std::sort(values.begin(), values.end());
+
+  EXPECT_EQ(expected, values);
+  EXPECT_EQ(5, values.cend() - values.cbegin());
+  EXPECT_EQ(fraction_t(1, 3), values.begin()[2]);
+  EXPECT_EQ(fraction_t(7), *(values.end() - 1));
+  EXPECT_TRUE(std::is_sorted(values.cbegin(), values.cend()));
+
+  fraction_vector_t::const_iterator it{values.begin()};
+
+  EXPECT_EQ(fraction_t(-1, 2), *it++);
+  EXPECT_EQ(fraction_t(0), *it);
+}
+
+TEST(TEST_CASE_NAME, arithmetic) {
+  const fraction_vector_t values1{{1, 2}, {-1, 3}, {5}};
+  const fraction_vector_t values2{{1, 4}, {2, 3}, {-1, 5}};
+
+  EXPECT_EQ(fraction_vector_t({{3, 4}, {1, 3}, {24, 5}}), values1 + values2);
+  EXPECT_EQ(fraction_vector_t({{1, 4}, {-1}, {26, 5}}), values1 - values2);
+  EXPECT_EQ(fraction_vector_t({{1, 8}, {-2, 9}, {-1}}), values1 * values2);
+  EXPECT_EQ(fraction_vector_t({{2}, {-1, 2}, {-25}}), values1 / values2);
+
+  EXPECT_EQ(fraction_vector_t({{1}, {1, 6}, {11, 2}}), values1 + fraction_t(1, 2));
+  EXPECT_EQ(fraction_vector_t({{0}, {5, 6}, {-9, 2}}), fraction_t(1, 2) - values1);
+  EXPECT_EQ(fraction_vector_t({{3, 2}, {-1}, {15}}), 3 * values1);
+  EXPECT_EQ(fraction_vector_t({{2}, {-3}, {1, 5}}), 1 / values1);
+}
+
+TEST(TEST_CASE_NAME, arithmeticLargeValues) {
+  constexpr std::int32_t max{std::numeric_limits<std::int32_t>::max()};
+
+  // Don't fit into std::int32_t before reducing
+  const fraction_vector32_t values1{{max, 2}, {1, max}, {-max, 3}, {max - 1, max}};
+  const fraction_vector32_t values2{{2, max}, {max}, {3, max}, {max, max - 1}};
+
+  EXPECT_EQ(fraction_vector32_t({{1}, {1}, {-1}, {1}}), values1 * values2);
+  EXPECT_EQ(fraction_vector32_t({{1}, {1}, {1}, {1}}), values1 / values1);
+  EXPECT_EQ(fraction_vector32_t(4), values1 - values1);
+
+  // Only the middle one doesn't fit before reducing
+  const fraction_vector32_t values3{{max, 2}, {max - 2, max}, {-1, max}};
+  const fraction_vector32_t values4{{-1}, {1, max}, {1}};
+
+  EXPECT_EQ(fraction_vector32_t({{max - 2, 2}, {max - 1, max}, {max - 1, max}}), values3 + values4);
+}
+
+TEST(TEST_CASE_NAME, kernels) {
+  const fraction_vector_t values1{{1, 2}, {-1, 3}, {5}};
+  const fraction_vector_t values2{{1, 4}, {2, 3}, {-1, 5}};
+  fraction_vector_t values3{values2};
+
+  fractionAxpy(fraction_t{2}, values1, values3);
+
+  EXPECT_EQ(fraction_t(31, 6), fractionSum(values1));
+  EXPECT_EQ(fraction_t(-79, 72), fractionDot(values1, values2));
+  EXPECT_EQ(fraction_vector_t({{5, 4}, {0}, {49, 5}}), values3);
+}
+
+TEST(TEST_CASE_NAME, exceptions) {
+  fraction_vector_t values1(3);
+  const fraction_vector_t values2(4);
+
+  EXPECT_THROW(values1 += values2, std::invalid_argument);
+  EXPECT_THROW(values2 / values1, std::invalid_argument);
+  EXPECT_THROW(values1 / fraction_t{0}, std::invalid_argument);
+  EXPECT_THROW(fractionDot(values1, values2), std::invalid_argument);
+  EXPECT_THROW(fractionAxpy(fraction_t{1}, values2, values1), std::invalid_argument);
+
+  // Elements are left unchanged when one of them throws
+  fraction_vector32_t values3{{1, 2}, {std::numeric_limits<std::int32_t>::max()}, {1, 3}};
+  const fraction_vector32_t expected{values3};
+
+  EXPECT_THROW(values3 += fraction32_t{1}, std::overflow_error);
+  EXPECT_EQ(expected, values3);
+  EXPECT_THROW(values3 /= fraction_vector32_t({{1}, {1}, {0}}), std::invalid_argument);
+  EXPECT_EQ(expected, values3);
+}
@@ -2,7 +2,9 @@
 // Copyright (c) 2018 Yannick Schinko
 // Licensed under the MIT License. See LICENSE file in the project root for full license information.
 //
+#include <cstring>
 #include <sstream>
+#include <string>
 
 #include <gtest/gtest.h>
 
@@ -201,6 +203,44 @@ TEST(TEST_CASE_NAME, lessThan) {
   EXPECT_FALSE(val7 < val7);
 }
 
+TEST(TEST_CASE_NAME, lessThanCloseValues) {
+  constexpr std::int64_t max{std::numeric_limits<std::int64_t>::max()};
+
+  // Too close to each other to be told apart as doubles
+  constexpr fraction_t val1{max - 2, max - 1};
+  constexpr fraction_t val2{max - 1, max};
+  constexpr fraction_t val3{-val2};
+  constexpr fraction_t val4{-val1};
+
+  EXPECT_LT(val1, val2);
+  EXPECT_FALSE(val2 < val1);
+  EXPECT_LT(val3, val4);
+  EXPECT_LT(val4, val2);
+  EXPECT_FALSE(val4 < val3);
+}
+
+#ifdef FRACTION_HAS_THREE_WAY_COMPARISON
+TEST(TEST_CASE_NAME, threeWayComparison) {
+  constexpr std::int64_t max{std::numeric_limits<std::int64_t>::max()};
+
+  constexpr fraction_t val1{max - 2, max - 1};
+  constexpr fraction_t val2{max - 1, max};
+  constexpr fraction_t val3{-val2};
+  constexpr fraction_t val4{1, 2};
+
+  static_assert((val1 <=> val2) == std::strong_ordering::less);
+  static_assert((val2 <=> val1) == std::strong_ordering::greater);
+  static_assert((val3 <=> val3) == std::strong_ordering::equal);
+  static_assert((val3 <=> val2) == std::strong_ordering::less);
+
+  EXPECT_EQ(std::strong_ordering::equal, val4 <=> 0.5);
+  EXPECT_EQ(std::strong_ordering::less, val4 <=> 1);
+  EXPECT_EQ(std::strong_ordering::greater, 1 <=> val4);
+  EXPECT_EQ(std::strong_ordering::equal, val4 <=> ufraction_t(1, 2));
+  EXPECT_EQ(std::strong_ordering::less, ufraction_t(1, 3) <=> val4);
+}
+#endif
+
 TEST(TEST_CASE_NAME, greaterThan) {
   constexpr fraction_t val1{std::numeric_limits<fraction_t>::max()};
   constexpr fraction_t val2{2, 1};
@@ -321,6 +361,45 @@ TEST(TEST_CASE_NAME, greaterThanOrEquals) {
   EXPECT_TRUE(val7 >= val7);
 }
 
+TEST(TEST_CASE_NAME, differentTypeComparison) {
+  constexpr fraction32_t val1{1, 2};
+  constexpr fraction_t val2{1, 3};
+  constexpr fraction32_t val3{-83, 141};
+  constexpr fraction_t val4{-12714, 1616795};
+
+  EXPECT_GT(val1, val2);
+  EXPECT_FALSE(val2 > val1);
+  EXPECT_GT(val4, val3);
+  EXPECT_FALSE(val3 > val4);
+  EXPECT_FALSE(val1 > fraction_t(1, 2));
+
+  EXPECT_GE(val1, val2);
+  EXPECT_FALSE(val2 >= val1);
+  EXPECT_GE(val4, val3);
+  EXPECT_FALSE(val3 >= val4);
+  EXPECT_GE(val1, fraction_t(1, 2));
+
+  EXPECT_LE(val2, val1);
+  EXPECT_FALSE(val1 <= val2);
+  EXPECT_LE(val3, val4);
+  EXPECT_FALSE(val4 <= val3);
+  EXPECT_LE(val1, fraction_t(1, 2));
+
+  EXPECT_LT(val2, val1);
+  EXPECT_FALSE(val1 < val2);
+
+  EXPECT_GT(val1, 0);
+  EXPECT_GT(1, val1);
+  EXPECT_GE(val1, 0.5);
+  EXPECT_GE(0.5, val1);
+  EXPECT_FALSE(val1 >= 1);
+  EXPECT_FALSE(0 >= val1);
+  EXPECT_LE(val2, 0.5);
+  EXPECT_LE(-1, val3);
+  EXPECT_FALSE(val2 <= 0);
+  EXPECT_FALSE(1 <= val2);
+}
+
 TEST(TEST_CASE_NAME, floatingPointConstructor) {
   constexpr fraction_t val1{2.0};
   constexpr fraction_t val2{-0.588652482269503546099290780141843971};
@@ -350,6 +429,113 @@ TEST(TEST_CASE_NAME, floatingPointConstructor) {
   EXPECT_EQ(val4Expected, val4);
 }
 
+TEST(TEST_CASE_NAME, floatingPointConstructorExact) {
+  constexpr fraction_t val1{0.75};
+  constexpr fraction_t val2{-1.0 / 1024.0};
+  constexpr fraction_t val3{static_cast<double>(std::numeric_limits<std::int64_t>::min())};
+  constexpr fraction_t val4{1e18};
+
+  constexpr fraction_t val1Expected{3, 4};
+  constexpr fraction_t val2Expected{-1, 1024};
+  constexpr fraction_t val3Expected{std::numeric_limits<std::int64_t>::min()};
+  constexpr fraction_t val4Expected{1'000'000'000'000'000'000};
+
+  EXPECT_EQ(val1Expected, val1);
+  EXPECT_NE(val2Expected, val1);
+  EXPECT_NE(val3Expected, val1);
+  EXPECT_NE(val4Expected, val1);
+  EXPECT_NE(val1Expected, val2);
+  EXPECT_EQ(val2Expected, val2);
+  EXPECT_NE(val3Expected, val2);
+  EXPECT_NE(val4Expected, val2);
+  EXPECT_NE(val1Expected, val3);
+  EXPECT_NE(val2Expected, val3);
+  EXPECT_EQ(val3Expected, val3);
+  EXPECT_NE(val4Expected, val3);
+  EXPECT_NE(val1Expected, val4);
+  EXPECT_NE(val2Expected, val4);
+  EXPECT_NE(val3Expected, val4);
+  EXPECT_EQ(val4Expected, val4);
+}
+
+TEST(TEST_CASE_NAME, floatingPointConstructorException) {
+  EXPECT_THROW(fraction_t(std::numeric_limits<double>::quiet_NaN()), std::invalid_argument);
+  EXPECT_THROW(fraction_t(std::numeric_limits<double>::infinity()), std::overflow_error);
+  EXPECT_THROW(fraction_t(-std::numeric_limits<double>::infinity()), std::overflow_error);
+  EXPECT_THROW(fraction_t(1e19), std::overflow_error);
+  EXPECT_THROW(fraction_t(-1e19), std::overflow_error);
+  EXPECT_THROW(fraction32_t(2147483648.5), std::overflow_error);
+  EXPECT_THROW(fraction32_t(-2147483648.5), std::overflow_error);
+  EXPECT_EQ(fraction32_t(std::numeric_limits<std::int32_t>::min()), fraction32_t(-2147483648.0));
+}
+
+TEST(TEST_CASE_NAME, limitDenominator) {
+  constexpr fraction_t pi{3141592653589793, 1000000000000000};
+
+  constexpr fraction_t val1{pi.limitDenominator(10)};
+  constexpr fraction_t val2{pi.limitDenominator(100)};
+  constexpr fraction_t val3{(-pi).limitDenominator(1000)};
+  constexpr fraction_t val4{fraction_t{1, 2}.limitDenominator(1)};
+
+  constexpr fraction_t val1Expected{22, 7};
+  constexpr fraction_t val2Expected{311, 99};
+  constexpr fraction_t val3Expected{-355, 113};
+  constexpr fraction_t val4Expected{0};
+
+  EXPECT_EQ(val1Expected, val1);
+  EXPECT_NE(val2Expected, val1);
+  EXPECT_NE(val3Expected, val1);
+  EXPECT_NE(val4Expected, val1);
+  EXPECT_NE(val1Expected, val2);
+  EXPECT_EQ(val2Expected, val2);
+  EXPECT_NE(val3Expected, val2);
+  EXPECT_NE(val4Expected, val2);
+  EXPECT_NE(val1Expected, val3);
+  EXPECT_NE(val2Expected, val3);
+  EXPECT_EQ(val3Expected, val3);
+  EXPECT_NE(val4Expected, val3);
+  EXPECT_NE(val1Expected, val4);
+  EXPECT_NE(val2Expected, val4);
+  EXPECT_NE(val3Expected, val4);
+  EXPECT_EQ(val4Expected, val4);
+
+  EXPECT_EQ(pi, pi.limitDenominator(std::numeric_limits<std::int64_t>::max()));
+  EXPECT_EQ(fraction_t(1, 3), fraction_t(1, 4).limitDenominator(3));
+  EXPECT_EQ(fraction_t(std::numeric_limits<std::int64_t>::min()),
+            fraction_t(std::numeric_limits<std::int64_t>::min()).limitDenominator(1));
+
+  // Ties go to the convergent of the signed value, like in Python
+  EXPECT_EQ(fraction_t(-1), fraction_t(-1, 2).limitDenominator(1));
+  EXPECT_EQ(fraction_t(2), fraction_t(5, 2).limitDenominator(1));
+  EXPECT_EQ(fraction_t(-3), fraction_t(-5, 2).limitDenominator(1));
+  EXPECT_EQ(fraction_t(-1, 2), fraction_t(-7, 12).limitDenominator(3));
+  EXPECT_EQ(fraction_t(-1), fraction_t(-3, 4).limitDenominator(2));
+  EXPECT_EQ(fraction_t(-2136597612217247873), fraction_t(-4273195224434495745, 2).limitDenominator(1));
+}
+
+TEST(TEST_CASE_NAME, limitDenominatorFloatingPoint) {
+  constexpr std::int64_t max{std::numeric_limits<std::int64_t>::max()};
+
+  EXPECT_EQ(fraction32_t(355, 113), fraction32_t::limitDenominator(3.141592653589793, 1000));
+  EXPECT_EQ(fraction32_t(-94053, 29938), fraction32_t::limitDenominator(-3.141592653589793, 30000));
+  EXPECT_EQ(fraction32_t(1, 10), fraction32_t::limitDenominator(0.1, 1'000'000));
+  EXPECT_EQ(fraction32_t(0), fraction32_t::limitDenominator(1e-30, 1'000'000));
+  EXPECT_EQ(fraction32_t(7), fraction32_t::limitDenominator(7.0, 1));
+  EXPECT_EQ(fraction_t(-521124860401442), fraction_t::limitDenominator(-0x1.d9f5d63017218p+48, 1));
+  EXPECT_EQ(fraction_t(521124860401441), fraction_t::limitDenominator(0x1.d9f5d63017218p+48, 1));
+  EXPECT_EQ(fraction_t(1, max), fraction_t::limitDenominator(1e-19, max));
+  // The exact value of the double
+  EXPECT_EQ(fraction_t(3602879701896397, 36028797018963968), fraction_t::limitDenominator(0.1, max));
+  EXPECT_EQ(ufraction32_t(2, 3), ufraction32_t::limitDenominator(0.6667f, 10u));
+
+  EXPECT_THROW(fraction32_t::limitDenominator(0.5, 0), std::invalid_argument);
+  EXPECT_THROW(fraction_t(1, 2).limitDenominator(-1), std::invalid_argument);
+  EXPECT_THROW(fraction32_t::limitDenominator(std::numeric_limits<double>::quiet_NaN(), 10), std::invalid_argument);
+  EXPECT_THROW(ufraction32_t::limitDenominator(-0.5, 10u), std::invalid_argument);
+  EXPECT_THROW(fraction32_t::limitDenominator(2147483647.7, 1), std::overflow_error);
+  EXPECT_THROW(fraction32_t::limitDenominator(std::numeric_limits<double>::infinity(), 1), std::overflow_error);
+}
+
 TEST(TEST_CASE_NAME, differentTypeConstructor) {
   constexpr std::int64_t factor{std::numeric_limits<std::int32_t>::max()};
 
@@ -483,6 +669,36 @@ TEST(TEST_CASE_NAME, differentTypeConversion) {
   EXPECT_EQ(val4Expected, val4Actual);
 }
 
+TEST(TEST_CASE_NAME, toFloatingPoint) {
+  constexpr fraction_t val1{9007199254740993};
+  constexpr fraction_t val2{-9007199254740993};
+  constexpr fraction_t val3{1, 3};
+  constexpr fraction_t val4{16777217};
+
+  // 2^53 + 1 lies exactly between two doubles
+  EXPECT_EQ(9007199254740992.0, val1.toFloatingPoint<double>());
+  EXPECT_EQ(9007199254740992.0, static_cast<double>(val1));
+  EXPECT_EQ(9007199254740994.0, val1.toFloatingPoint<double>(std::round_toward_infinity));
+  EXPECT_EQ(9007199254740992.0, val1.toFloatingPoint<double>(std::round_toward_neg_infinity));
+  EXPECT_EQ(9007199254740992.0, val1.toFloatingPoint<double>(std::round_toward_zero));
+  EXPECT_EQ(-9007199254740992.0, val2.toFloatingPoint<double>());
+  EXPECT_EQ(-9007199254740992.0, val2.toFloatingPoint<double>(std::round_toward_infinity));
+  EXPECT_EQ(-9007199254740994.0, val2.toFloatingPoint<double>(std::round_toward_neg_infinity));
+  EXPECT_EQ(-9007199254740992.0, val2.toFloatingPoint<double>(std::round_toward_zero));
+  EXPECT_EQ(0x1.555556p-2f, val3.toFloatingPoint<float>());
+  EXPECT_EQ(0x1.555556p-2f, val3.toFloatingPoint<float>(std::round_toward_infinity));
+  EXPECT_EQ(0x1.555554p-2f, val3.toFloatingPoint<float>(std::round_toward_neg_infinity));
+  EXPECT_EQ(0x1.555554p-2f, val3.toFloatingPoint<float>(std::round_toward_zero));
+  EXPECT_EQ(16777216.0f, val4.toFloatingPoint<float>());
+  EXPECT_EQ(16777218.0f, val4.toFloatingPoint<float>(std::round_toward_infinity));
+
+  // Rounding twice (first to double, then to float) would end on 1 instead
+  constexpr fraction_t val5{(std::int64_t{1} << 55) + (std::int64_t{1} << 31) + 1, std::int64_t{1} << 55};
+
+  EXPECT_EQ(0x1.000002p0f, val5.toFloatingPoint<float>());
+  EXPECT_EQ(0x1.000002p0f, static_cast<float>(val5));
+}
+
 TEST(TEST_CASE_NAME, addition) {
   constexpr fraction_t val1Expected{2, 1};
   constexpr fraction_t val2Expected{-83, 141};
@@ -939,6 +1155,97 @@ TEST(TEST_CASE_NAME, differentTypesDivision) {
   EXPECT_EQ(val4Expected, val4Actual);
 }
 
+TEST(TEST_CASE_NAME, wideIntermediates) {
+  constexpr fraction_t val1Expected{1, 2000000000};
+  constexpr fraction_t val2Expected{-1, 2000000000};
+  constexpr fraction_t val3Expected{3, 2};
+  constexpr fraction_t val4Expected{1, 1};
+
+  constexpr fraction_t val1Lhs{1, 4000000000};
+  constexpr fraction_t val2Lhs{1, 4000000000};
+  constexpr fraction_t val3Lhs{5000000000, 7};
+  constexpr fraction_t val4Lhs{6000000001, 4000000001};
+  constexpr fraction_t val1Rhs{1, 4000000000};
+  constexpr fraction_t val2Rhs{3, 4000000000};
+  constexpr fraction_t val3Rhs{21, 10000000000};
+  constexpr fraction_t val4Rhs{6000000001, 4000000001};
+
+  constexpr fraction_t val1Actual{val1Lhs + val1Rhs};
+  constexpr fraction_t val2Actual{val2Lhs - val2Rhs};
+  constexpr fraction_t val3Actual{val3Lhs * val3Rhs};
+  constexpr fraction_t val4Actual{val4Lhs / val4Rhs};
+
+  EXPECT_EQ(val1Expected, val1Actual);
+  EXPECT_NE(val2Expected, val1Actual);
+  EXPECT_NE(val3Expected, val1Actual);
+  EXPECT_NE(val4Expected, val1Actual);
+  EXPECT_NE(val1Expected, val2Actual);
+  EXPECT_EQ(val2Expected, val2Actual);
+  EXPECT_NE(val3Expected, val2Actual);
+  EXPECT_NE(val4Expected, val2Actual);
+  EXPECT_NE(val1Expected, val3Actual);
+  EXPECT_NE(val2Expected, val3Actual);
+  EXPECT_EQ(val3Expected, val3Actual);
+  EXPECT_NE(val4Expected, val3Actual);
+  EXPECT_NE(val1Expected, val4Actual);
+  EXPECT_NE(val2Expected, val4Actual);
+  EXPECT_NE(val3Expected, val4Actual);
+  EXPECT_EQ(val4Expected, val4Actual);
+}
+
+TEST(TEST_CASE_NAME, overflowException) {
+  EXPECT_THROW(fraction_t{std::numeric_limits<std::int64_t>::max()} + fraction_t{1}, std::overflow_error);
+  EXPECT_THROW(fraction_t{std::numeric_limits<std::int64_t>::max()} * fraction_t{2}, std::overflow_error);
+  EXPECT_THROW(++fraction_t{std::numeric_limits<std::int64_t>::max()}, std::overflow_error);
+  EXPECT_THROW(--fraction_t{std::numeric_limits<std::int64_t>::min()}, std::overflow_error);
+  EXPECT_THROW(-fraction_t{std::numeric_limits<std::int64_t>::min()}, std::overflow_error);
+}
+
+TEST(TEST_CASE_NAME, incrementDecrement) {
+  constexpr fraction_t val1Expected{1, 1};
+  constexpr fraction_t val2Expected{-1, 3};
+  constexpr fraction_t val3Expected{1616795 - 12714, 1616795};
+  constexpr fraction_t val4Expected{-2, 1};
+
+  constexpr fraction_t val1Actual{[] {
+    fraction_t value{};
+    return ++value;
+  }()};
+  constexpr fraction_t val2Actual{[] {
+    fraction_t value{-7, 3};
+    ++value;
+    return ++value;
+  }()};
+  constexpr fraction_t val3Actual{[] {
+    fraction_t value{-12714, 1616795};
+    value++;
+    return value;
+  }()};
+  constexpr fraction_t val4Actual{[] {
+    fraction_t value{0, 1};
+    --value;
+    value--;
+    return value;
+  }()};
+
+  EXPECT_EQ(val1Expected, val1Actual);
+  EXPECT_NE(val2Expected, val1Actual);
+  EXPECT_NE(val3Expected, val1Actual);
+  EXPECT_NE(val4Expected, val1Actual);
+  EXPECT_NE(val1Expected, val2Actual);
+  EXPECT_EQ(val2Expected, val2Actual);
+  EXPECT_NE(val3Expected, val2Actual);
+  EXPECT_NE(val4Expected, val2Actual);
+  EXPECT_NE(val1Expected, val3Actual);
+  EXPECT_NE(val2Expected, val3Actual);
+  EXPECT_EQ(val3Expected, val3Actual);
+  EXPECT_NE(val4Expected, val3Actual);
+  EXPECT_NE(val1Expected, val4Actual);
+  EXPECT_NE(val2Expected, val4Actual);
+  EXPECT_NE(val3Expected, val4Actual);
+  EXPECT_EQ(val4Expected, val4Actual);
+}
+
 TEST(TEST_CASE_NAME, sign) {
   constexpr fraction_t val1Expected{2, 1};
   constexpr fraction_t val2Expected{-83, 141};
@@ -1060,3 +1367,225 @@ TEST(TEST_CASE_NAME, wostream) {
   EXPECT_NE(val3Expected, val4Actual);
   EXPECT_EQ(val4Expected, val4Actual);
 }
+
+namespace {
+constexpr fraction_t parse(const char* text, std::size_t length) {
+  fraction_t value{7, 3};
+
+  fraction_from_chars(text, text + length, value);
+
+  return value;
+}
+}  // namespace
+
+TEST(TEST_CASE_NAME, fromChars) {
+  constexpr fraction_t val1Expected{-2, 3};
+  constexpr fraction_t val2Expected{12};
+  constexpr fraction_t val3Expected{-99, 8};
+  constexpr fraction_t val4Expected{3, 2000};
+
+  constexpr fraction_t val1Actual{parse("-4/6", 4)};
+  constexpr fraction_t val2Actual{parse("12", 2)};
+  constexpr fraction_t val3Actual{parse("-12.375", 7)};
+  constexpr fraction_t val4Actual{parse("1.5e-3", 6)};
+
+  EXPECT_EQ(val1Expected, val1Actual);
+  EXPECT_NE(val2Expected, val1Actual);
+  EXPECT_NE(val3Expected, val1Actual);
+  EXPECT_NE(val4Expected, val1Actual);
+  EXPECT_NE(val1Expected, val2Actual);
+  EXPECT_EQ(val2Expected, val2Actual);
+  EXPECT_NE(val3Expected, val2Actual);
+  EXPECT_NE(val4Expected, val2Actual);
+  EXPECT_NE(val1Expected, val3Actual);
+  EXPECT_NE(val2Expected, val3Actual);
+  EXPECT_EQ(val3Expected, val3Actual);
+  EXPECT_NE(val4Expected, val3Actual);
+  EXPECT_NE(val1Expected, val4Actual);
+  EXPECT_NE(val2Expected, val4Actual);
+  EXPECT_NE(val3Expected, val4Actual);
+  EXPECT_EQ(val4Expected, val4Actual);
+}
+
+TEST(TEST_CASE_NAME, fromCharsEdgeCases) {
+  const auto check = [](const char* text, const fraction_t& expected, std::size_t expectedLength) {
+    fraction_t actual{7, 3};
+    const std::from_chars_result result{fraction_from_chars(text, text + std::strlen(text), actual)};
+
+    EXPECT_EQ(std::errc{}, result.ec) << text;
+    EXPECT_EQ(expectedLength, static_cast<std::size_t>(result.ptr - text)) << text;
+    EXPECT_EQ(expected, actual) << text;
+  };
+  const auto checkError = [](const char* text, std::errc expected, std::size_t expectedLength) {
+    fraction_t actual{7, 3};
+    const std::from_chars_result result{fraction_from_chars(text, text + std::strlen(text), actual)};
+
+    EXPECT_EQ(expected, result.ec) << text;
+    EXPECT_EQ(expectedLength, static_cast<std::size_t>(result.ptr - text)) << text;
+    EXPECT_EQ(fraction_t(7, 3), actual) << text;
+  };
+
+  check("100/1000", fraction_t(1, 10), 8);
+  check("0/5", fraction_t(0), 3);
+  check("5.", fraction_t(5), 2);
+  check("-.5", fraction_t(-1, 2), 3);
+  check("2.5E+2x", fraction_t(250), 6);
+  check("3/x", fraction_t(3), 1);
+  check("1e", fraction_t(1), 1);
+  check("-9223372036854775808", fraction_t(std::numeric_limits<std::int64_t>::min()), 20);
+  // Intermediates may exceed the range as long as the reduced result fits
+  check("18446744073709551614/2", fraction_t(std::numeric_limits<std::int64_t>::max()), 22);
+  check("0.000000000931322574615478515625", fraction_t(1, 1073741824), 32);
+  check("1.0000000000000000000000000000000000000000", fraction_t(1), 42);
+  check("0e400", fraction_t(0), 5);
+
+  checkError("", std::errc::invalid_argument, 0);
+  checkError("-", std::errc::invalid_argument, 0);
+  checkError(".", std::errc::invalid_argument, 0);
+  checkError("+1", std::errc::invalid_argument, 0);
+  checkError(" 1", std::errc::invalid_argument, 0);
+  checkError("1/0", std::errc::invalid_argument, 0);
+  checkError("9223372036854775808", std::errc::result_out_of_range, 19);
+  checkError("1/18446744073709551616", std::errc::result_out_of_range, 22);
+  checkError("1e-19", std::errc::result_out_of_range, 5);
+  checkError("1e400", std::errc::result_out_of_range, 5);
+}
+
+TEST(TEST_CASE_NAME, istream) {
+  std::stringstream stream{"  2/1 -83/141\t-12714/1616795\n0 1.25e1 1/ 3"};
+  fraction_t val1{};
+  fraction_t val2{};
+  fraction_t val3{};
+  fraction_t val4{};
+  fraction_t val5{};
+
+  stream >> val1 >> val2 >> val3 >> val4 >> val5;
+
+  EXPECT_TRUE(stream.good());
+  EXPECT_EQ(fraction_t(2, 1), val1);
+  EXPECT_EQ(fraction_t(-83, 141), val2);
+  EXPECT_EQ(fraction_t(-12714, 1616795), val3);
+  EXPECT_EQ(fraction_t(0, 1), val4);
+  EXPECT_EQ(fraction_t(25, 2), val5);
+
+  stream >> val1;
+
+  EXPECT_TRUE(stream.fail());
+}
+
+TEST(TEST_CASE_NAME, wistream) {
+  std::wstringstream stream{L"-5/10"};
+  fraction_t val{};
+
+  stream >> val;
+
+  EXPECT_FALSE(stream.fail());
+  EXPECT_TRUE(stream.eof());
+  EXPECT_EQ(fraction_t(-1, 2), val);
+}
+
+namespace {
+std::string format(const fraction_t& value, fraction_chars_format format, int precision = -1) {
+  char buffer[64];
+  const std::to_chars_result result{to_chars(buffer, buffer + sizeof(buffer), value, format, precision)};
+
+  EXPECT_EQ(std::errc{}, result.ec);
+
+  return std::string(buffer, result.ptr);
+}
+}  // namespace
+
+TEST(TEST_CASE_NAME, toChars) {
+  constexpr fraction_t val1{2, 1};
+  constexpr fraction_t val2{-83, 141};
+  constexpr fraction_t val3{-7, 2};
+  constexpr fraction_t val4{0, 1};
+
+  EXPECT_EQ("2/1", format(val1, fraction_chars_format::fraction));
+  EXPECT_EQ("-83/141", format(val2, fraction_chars_format::fraction));
+  EXPECT_EQ("-7/2", format(val3, fraction_chars_format::fraction));
+  EXPECT_EQ("0/1", format(val4, fraction_chars_format::fraction));
+  EXPECT_EQ("2", format(val1, fraction_chars_format::compact));
+  EXPECT_EQ("-83/141", format(val2, fraction_chars_format::compact));
+  EXPECT_EQ("-7/2", format(val3, fraction_chars_format::compact));
+  EXPECT_EQ("0", format(val4, fraction_chars_format::compact));
+  EXPECT_EQ("2", format(val1, fraction_chars_format::mixed));
+  EXPECT_EQ("-83/141", format(val2, fraction_chars_format::mixed));
+  EXPECT_EQ("-3 1/2", format(val3, fraction_chars_format::mixed));
+  EXPECT_EQ("0", format(val4, fraction_chars_format::mixed));
+  EXPECT_EQ("2.000000", format(val1, fraction_chars_format::fixed));
+  EXPECT_EQ("-0.588652", format(val2, fraction_chars_format::fixed));
+  EXPECT_EQ("-3.50", format(val3, fraction_chars_format::fixed, 2));
+  EXPECT_EQ("0", format(val4, fraction_chars_format::fixed, 0));
+
+  // Ties round to even, and carries run through all digits
+  EXPECT_EQ("-0.12", format(fraction_t(-1, 8), fraction_chars_format::fixed, 2));
+  EXPECT_EQ("0.38", format(fraction_t(3, 8), fraction_chars_format::fixed, 2));
+  EXPECT_EQ("2", format(fraction_t(5, 2), fraction_chars_format::fixed, 0));
+  EXPECT_EQ("10.000", format(fraction_t(19999, 2000), fraction_chars_format::fixed, 3));
+  EXPECT_EQ("-9223372036854775808/1",
+            format(fraction_t(std::numeric_limits<std::int64_t>::min()), fraction_chars_format::fraction));
+  EXPECT_EQ("0.00000000000000000011",
+            format(fraction_t(1, std::numeric_limits<std::int64_t>::max()), fraction_chars_format::fixed, 20));
+
+  constexpr std::size_t length{[]() {
+    char buffer[16]{};
+
+    return static_cast<std::size_t>(to_chars(buffer, buffer + 16, fraction_t{-7, 2}).ptr - buffer);
+  }()};
+
+  EXPECT_EQ(4U, length);
+
+  char buffer[4];
+  const std::to_chars_result result{to_chars(buffer, buffer + 4, fraction_t{123, 4})};
+
+  EXPECT_EQ(std::errc::value_too_large, result.ec);
+  EXPECT_EQ(buffer + 4, result.ptr);
+
+  // Fails before computing any digits, or this wouldn't be a constant expression
+  constexpr std::errc hugePrecision{[]() {
+    char buffer[8]{};
+
+    return to_chars(buffer, buffer + 8, fraction_t{1, 3}, fraction_chars_format::fixed,
+                    std::numeric_limits<int>::max())
+        .ec;
+  }()};
+
+  EXPECT_EQ(std::errc::value_too_large, hugePrecision);
+}
+
+#ifdef FRACTION_HAS_FORMAT
+TEST(TEST_CASE_NAME, format) {
+  EXPECT_EQ("-7/2", std::format("{}", fraction_t{-7, 2}));
+  EXPECT_EQ("4", std::format("{:c}", fraction_t{4}));
+  EXPECT_EQ("-3 1/2", std::format("{:m}", fraction_t{-7, 2}));
+  EXPECT_EQ("0.333333", std::format("{:f}", fraction_t{1, 3}));
+  EXPECT_EQ("0.67", std::format("{:.2f}", fraction_t{2, 3}));
+  EXPECT_EQ(L"3 1/2", std::format(L"{:m}", fraction_t{7, 2}));
+
+  // Width, fill and alignment work like for numbers
+  EXPECT_EQ("  -7/2", std::format("{:6}", fraction_t{-7, 2}));
+  EXPECT_EQ("-7/2  ", std::format("{:<6}", fraction_t{-7, 2}));
+  EXPECT_EQ("*-7/2**", std::format("{:*^7}", fraction_t{-7, 2}));
+  EXPECT_EQ("___0.67", std::format("{:_>7.2f}", fraction_t{2, 3}));
+  EXPECT_EQ("-3 1/2", std::format("{:3m}", fraction_t{-7, 2}));
+  EXPECT_EQ(L"..3 1/2", std::format(L"{:.>7m}", fraction_t{7, 2}));
+
+  // An alignment after the closing brace is just text
+  EXPECT_EQ("<-7/2>", std::format("<{}>", fraction_t{-7, 2}));
+  EXPECT_EQ("-7/2>", std::format("{}>", fraction_t{-7, 2}));
+  EXPECT_EQ("[-7/2<]", std::format("[{:}<]", fraction_t{-7, 2}));
+
+  fraction_t value{};
+  std::size_t width{5};
+
+  EXPECT_THROW(static_cast<void>(std::vformat("{:.2}", std::make_format_args(value))), std::format_error);
+  EXPECT_THROW(static_cast<void>(std::vformat("{:x}", std::make_format_args(value))), std::format_error);
+  EXPECT_THROW(static_cast<void>(std::vformat("{:+}", std::make_format_args(value))), std::format_error);
+  EXPECT_THROW(static_cast<void>(std::vformat("{:05}", std::make_format_args(value))), std::format_error);
+  EXPECT_THROW(static_cast<void>(std::vformat("{:#}", std::make_format_args(value))), std::format_error);
+  EXPECT_THROW(static_cast<void>(std::vformat("{:{}}", std::make_format_args(value, width))), std::format_error);
+}
+#elif defined(CXX20_TESTING)
+#error "CXX20_TESTING is set, but std::format is not available, so the formatter would not be tested"
+#endif
@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+
+#define TEST_CASE_NAME ConstexprTest_lazy_fraction
+
+TEST(TEST_CASE_NAME, zeroExcpetion) { EXPECT_THROW(lazy_fraction_t(1, 0), std::invalid_argument); }
+
+TEST(TEST_CASE_NAME, deferredReduction) {
+  constexpr lazy_fraction_t val1{lazy_fraction_t{1, 2} + lazy_fraction_t{1, 2}};
+  constexpr lazy_fraction_t val2{lazy_fraction_t{-2, -4} * lazy_fraction_t{6, 3}};
+  constexpr lazy_fraction_t val3{lazy_fraction_t{3, -6}};
+
+  EXPECT_EQ(4, val1.getNumerator());
+  EXPECT_EQ(4, val1.getDenominator());
+  EXPECT_EQ(12, val2.getNumerator());
+  EXPECT_EQ(12, val2.getDenominator());
+  EXPECT_EQ(-3, val3.getNumerator());
+  EXPECT_EQ(6, val3.getDenominator());
+
+  EXPECT_EQ(fraction_t(1, 1), val1.reduced());
+  EXPECT_EQ(fraction_t(1, 1), val2.reduced());
+  EXPECT_EQ(fraction_t(-1, 2), val3.reduced());
+}
+
+TEST(TEST_CASE_NAME, operationChain) {
+  constexpr fraction_t val1{7899, 1235};
+  constexpr fraction_t val2{-1216264, 174135};
+  constexpr fraction_t val3{-4565, 5464};
+  constexpr fraction_t val4{7311199879, 8834167880};
+
+  constexpr fraction_t expected{((((val1 + val2) * val3) - val4) / val1) + val2};
+  constexpr lazy_fraction_t actual{((((lazy_fraction_t{val1} + val2) * val3) - val4) / val1) + val2};
+
+  EXPECT_EQ(expected, actual.reduced());
+  EXPECT_EQ(lazy_fraction_t{expected}, actual);
+  EXPECT_EQ(static_cast<double>(expected), static_cast<double>(actual));
+}
+
+TEST(TEST_CASE_NAME, reductionOnOverflow) {
+  fraction_t expected{};
+  lazy_fraction_t actual{};
+
+  // The unreduced denominator of the harmonic numbers grows factorially, while the reduced one still fits
+  for (std::int64_t i = 1; i <= 40; ++i) {
+    expected += fraction_t{1, i};
+    actual += lazy_fraction_t{1, i};
+  }
+
+  EXPECT_EQ(expected, actual.reduced());
+  EXPECT_LT(actual, lazy_fraction_t{5});
+  EXPECT_GT(actual, lazy_fraction_t{4});
+
+  // The sign of the denominator moves to the numerator. The minimum can't be negated, so it gets reduced first
+  constexpr std::int64_t min{std::numeric_limits<std::int64_t>::min()};
+  const lazy_fraction_t negated{min, -2};
+
+  EXPECT_EQ(std::int64_t{1} << 62, negated.getNumerator());
+  EXPECT_EQ(1, negated.getDenominator());
+  EXPECT_EQ(fraction_t(min, -2), negated.reduced());
+  EXPECT_EQ(-3, (lazy_fraction_t{3, -6}.getNumerator()));
+  EXPECT_EQ(6, (lazy_fraction_t{3, -6}.getDenominator()));
+}
+
+TEST(TEST_CASE_NAME, overflowException) {
+  EXPECT_THROW(lazy_fraction_t{std::numeric_limits<std::int64_t>::max()} + lazy_fraction_t{1}, std::overflow_error);
+  EXPECT_THROW(ulazy_fraction_t{std::numeric_limits<std::uint64_t>::max()} * ulazy_fraction_t{2}, std::overflow_error);
+  EXPECT_THROW((lazy_fraction_t{std::numeric_limits<std::int64_t>::min(), -1}), std::overflow_error);
+  EXPECT_THROW((lazy_fraction_t{1, std::numeric_limits<std::int64_t>::min()}), std::overflow_error);
+}
+
+TEST(TEST_CASE_NAME, ostream) {
+  std::stringstream stream;
+
+  stream << (lazy_fraction_t{1, 4} + lazy_fraction_t{1, 4});
+
+  EXPECT_EQ("1/2", stream.str());
+}
+
+TEST(TEST_CASE_NAME, hash) {
+  constexpr fraction_hash<> hasher{};
+  constexpr fraction_equal_to<> equal{};
+
+  constexpr std::size_t val1{hasher(fraction_t{1, 2})};
+  constexpr std::size_t val2{hasher(lazy_fraction_t{1, 2})};
+  constexpr std::size_t val3{hasher(lazy_fraction_t{-3, -6})};
+  constexpr std::size_t val4{hasher(lazy_fraction_t{1, 4} + lazy_fraction_t{1, 4})};
+  constexpr std::size_t val5{hasher(fraction_t{2, 1})};
+  constexpr std::size_t val6{hasher(fraction_t{-1, 2})};
+  constexpr std::size_t val7{hasher(lazy_fraction_t{0, 5})};
+  constexpr std::size_t val8{hasher(fraction_t{0})};
+
+  EXPECT_EQ(std::hash<fraction_t>{}(fraction_t{1, 2}), val1);
+  EXPECT_EQ(std::hash<lazy_fraction_t>{}(lazy_fraction_t{2, 4}), val1);
+  EXPECT_EQ(val1, val2);
+  EXPECT_EQ(val1, val3);
+  EXPECT_EQ(val1, val4);
+  EXPECT_EQ(val7, val8);
+
+  EXPECT_NE(val1, val5);
+  EXPECT_NE(val1, val6);
+
+  EXPECT_TRUE(equal(fraction_t{1, 2}, lazy_fraction_t{2, 4}));
+  EXPECT_TRUE(equal(lazy_fraction_t{2, 4}, lazy_fraction_t{-3, -6}));
+  EXPECT_FALSE(equal(lazy_fraction_t{2, 4}, fraction_t{2, 1}));
+}
@@ -2,6 +2,7 @@
 // Copyright (c) 2018 Yannick Schinko
 // Licensed under the MIT License. See LICENSE file in the project root for full license information.
 //
+#include <cstring>
 #include <sstream>
 
 #include <gtest/gtest.h>
@@ -201,6 +202,17 @@ TEST(TEST_CASE_NAME, lessThan) {
   EXPECT_FALSE(val7 < val7);
 }
 
+TEST(TEST_CASE_NAME, lessThanCloseValues) {
+  constexpr std::uint64_t max{std::numeric_limits<std::uint64_t>::max()};
+
+  // Too close to each other to be told apart as doubles
+  constexpr ufraction_t val1{max - 2, max - 1};
+  constexpr ufraction_t val2{max - 1, max};
+
+  EXPECT_LT(val1, val2);
+  EXPECT_FALSE(val2 < val1);
+}
+
 TEST(TEST_CASE_NAME, greaterThan) {
   constexpr ufraction_t val1{std::numeric_limits<ufraction_t>::max()};
   constexpr ufraction_t val2{2, 1};
@@ -941,6 +953,77 @@ TEST(TEST_CASE_NAME, differentTypesDivision) {
   EXPECT_EQ(val4Expected, val4Actual);
 }
 
+TEST(TEST_CASE_NAME, wideIntermediates) {
+  constexpr ufraction_t val1Expected{1, 4294967296};
+  constexpr ufraction_t val2Expected{1, 2147483648};
+  constexpr ufraction_t val3Expected{3, 2};
+  constexpr ufraction_t val4Expected{1, 1};
+
+  constexpr ufraction_t val1Lhs{1, 8589934592};
+  constexpr ufraction_t val2Lhs{5, 8589934592};
+  constexpr ufraction_t val3Lhs{10000000000, 7};
+  constexpr ufraction_t val4Lhs{6000000001, 4000000001};
+  constexpr ufraction_t val1Rhs{1, 8589934592};
+  constexpr ufraction_t val2Rhs{1, 8589934592};
+  constexpr ufraction_t val3Rhs{21, 20000000000};
+  constexpr ufraction_t val4Rhs{6000000001, 4000000001};
+
+  constexpr ufraction_t val1Actual{val1Lhs + val1Rhs};
+  constexpr ufraction_t val2Actual{val2Lhs - val2Rhs};
+  constexpr ufraction_t val3Actual{val3Lhs * val3Rhs};
+  constexpr ufraction_t val4Actual{val4Lhs / val4Rhs};
+
+  EXPECT_EQ(val1Expected, val1Actual);
+  EXPECT_NE(val2Expected, val1Actual);
+  EXPECT_NE(val3Expected, val1Actual);
+  EXPECT_NE(val4Expected, val1Actual);
+  EXPECT_NE(val1Expected, val2Actual);
+  EXPECT_EQ(val2Expected, val2Actual);
+  EXPECT_NE(val3Expected, val2Actual);
+  EXPECT_NE(val4Expected, val2Actual);
+  EXPECT_NE(val1Expected, val3Actual);
+  EXPECT_NE(val2Expected, val3Actual);
+  EXPECT_EQ(val3Expected, val3Actual);
+  EXPECT_NE(val4Expected, val3Actual);
+  EXPECT_NE(val1Expected, val4Actual);
+  EXPECT_NE(val2Expected, val4Actual);
+  EXPECT_NE(val3Expected, val4Actual);
+  EXPECT_EQ(val4Expected, val4Actual);
+}
+
+TEST(TEST_CASE_NAME, overflowException) {
+  EXPECT_THROW(ufraction_t{std::numeric_limits<std::uint64_t>::max()} + ufraction_t{1}, std::overflow_error);
+  EXPECT_THROW(ufraction_t{std::numeric_limits<std::uint64_t>::max()} * ufraction_t{2}, std::overflow_error);
+  EXPECT_THROW(++ufraction_t{std::numeric_limits<std::uint64_t>::max()}, std::overflow_error);
+}
+
+TEST(TEST_CASE_NAME, decrementWrapAround) {
+  constexpr std::uint64_t max{std::numeric_limits<std::uint64_t>::max()};
+
+  ufraction_t val1{};
+  ufraction_t val2{1, 3};
+  ufraction_t val3{7, 3};
+
+  --val1;
+  --val2;
+  --val3;
+
+  EXPECT_EQ(ufraction_t(max, 1), val1);
+  EXPECT_EQ(ufraction_t(max - 1, 3), val2);
+  EXPECT_EQ(ufraction_t(4, 3), val3);
+  EXPECT_EQ(ufraction_t(max - 1, 3), -ufraction_t(2, 3));
+}
+
+TEST(TEST_CASE_NAME, integerOperandsWrapAround) {
+  constexpr ufraction_t val1{1, 3};
+  constexpr ufraction_t val2{7, 3};
+
+  EXPECT_EQ(val1 - ufraction_t{1}, val1 - 1);
+  EXPECT_EQ(ufraction_t{2} - val2, 2 - val2);
+  EXPECT_EQ(ufraction_t(4, 3), val2 - 1u);
+  EXPECT_EQ(ufraction_t(0, 1), 7 - val2 * 3);
+}
+
 TEST(TEST_CASE_NAME, ostream) {
   constexpr ufraction_t val1{2, 1};
   constexpr ufraction_t val2{83, 141};
@@ -1028,3 +1111,24 @@ TEST(TEST_CASE_NAME, wostream) {
   EXPECT_NE(val3Expected, val4Actual);
   EXPECT_EQ(val4Expected, val4Actual);
 }
+
+TEST(TEST_CASE_NAME, fromChars) {
+  const auto parse = [](const char* text, ufraction_t& value) {
+    return fraction_from_chars(text, text + std::strlen(text), value);
+  };
+
+  ufraction_t value{};
+
+  EXPECT_EQ(std::errc{}, parse("18446744073709551615", value).ec);
+  EXPECT_EQ(ufraction_t(std::numeric_limits<std::uint64_t>::max()), value);
+  EXPECT_EQ(std::errc{}, parse("6/4", value).ec);
+  EXPECT_EQ(ufraction_t(3, 2), value);
+  EXPECT_EQ(std::errc{}, parse("0.125", value).ec);
+  EXPECT_EQ(ufraction_t(1, 8), value);
+
+  // Like std::from_chars, unsigned types don't accept a sign
+  EXPECT_EQ(std::errc::invalid_argument, parse("-1", value).ec);
+  EXPECT_EQ(std::errc::invalid_argument, parse("-0", value).ec);
+  EXPECT_EQ(std::errc::result_out_of_range, parse("18446744073709551616", value).ec);
+  EXPECT_EQ(ufraction_t(1, 8), value);
+}
@@ -0,0 +1,316 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+#include "rngTest/rngUtils.hpp"
+
+#define TEST_CASE_NAME RNGTest_fraction_batch
+
+// The AVX2 test builds have to run the vector kernels, not the scalar fallback
+#if defined(AVX2_TESTING) && !defined(FRACTION_HAS_AVX2)
+#error "AVX2_TESTING is set, but the AVX2 kernels are not compiled in"
+#endif
+
+TEST(TEST_CASE_NAME, reduceBatch) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x0c745b14};
+
+  runTest(
+      [](std::size_t caseNr) {
+        // Not a multiple of the vector width, so the scalar tail is covered as well
+        constexpr std::size_t count{37};
+
+        std::vector<std::int32_t> numerators(count);
+        std::vector<std::int32_t> denominators(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+          // Common factors make sure there is something to reduce
+          const std::int32_t factor{static_cast<std::int32_t>(1 << (i % 8)) * static_cast<std::int32_t>(i % 5 + 1)};
+
+          numerators[i] = (i % 7 == 0) ? 0 : (nextInt32() / factor) * factor;
+          denominators[i] = (nextInt32NoZero() / factor) * factor;
+
+          if (denominators[i] == 0) denominators[i] = -factor;
+        }
+
+        std::vector<fraction32_t> expected;
+
+        for (std::size_t i = 0; i < count; ++i)
+          expected.emplace_back(numerators[i], denominators[i]);
+
+        reduceBatch(numerators.data(), denominators.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+          EXPECT_EQ(expected[i].getNumerator(), numerators[i]) << "Case: " << caseNr << ", Index: " << i;
+          EXPECT_EQ(expected[i].getDenominator(), denominators[i]) << "Case: " << caseNr << ", Index: " << i;
+        }
+      },
+      seed);
+
+  runTest(
+      [](std::size_t caseNr) {
+        constexpr std::size_t count{13};
+
+        std::vector<std::int64_t> numerators(count);
+        std::vector<std::int64_t> denominators(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+          const std::int64_t factor{nextInt32NoZero()};
+
+          numerators[i] = nextInt32() * factor;
+          denominators[i] = nextInt32NoZero() * factor;
+        }
+
+        std::vector<fraction_t> expected;
+
+        for (std::size_t i = 0; i < count; ++i)
+          expected.emplace_back(numerators[i], denominators[i]);
+
+        reduceBatch(numerators.data(), denominators.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+          EXPECT_EQ(expected[i].getNumerator(), numerators[i]) << "Case: " << caseNr << ", Index: " << i;
+          EXPECT_EQ(expected[i].getDenominator(), denominators[i]) << "Case: " << caseNr << ", Index: " << i;
+        }
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, reduceBatchExtremes) {
+  constexpr std::int32_t min{std::numeric_limits<std::int32_t>::min()};
+  constexpr std::int32_t max{std::numeric_limits<std::int32_t>::max()};
+
+  std::vector<std::int32_t> numerators{min, 0, min, max, 1 - max, 6, min, 1, 0};
+  std::vector<std::int32_t> denominators{min, min, 2, max, 3, -4, max, -1, -7};
+  const std::vector<std::int32_t> numeratorsExpected{1, 0, min / 2, 1, (1 - max) / 3, -3, min, -1, 0};
+  const std::vector<std::int32_t> denominatorsExpected{1, 1, 1, 1, 1, 2, max, 1, 1};
+
+  reduceBatch(numerators.data(), denominators.data(), numerators.size());
+
+  EXPECT_EQ(numeratorsExpected, numerators);
+  EXPECT_EQ(denominatorsExpected, denominators);
+}
+
+TEST(TEST_CASE_NAME, reduceBatchExceptions) {
+  std::vector<std::int32_t> numerators(16, 1);
+  std::vector<std::int32_t> denominators(16, 1);
+
+  denominators[11] = 0;
+
+  EXPECT_THROW(reduceBatch(numerators.data(), denominators.data(), numerators.size()), std::invalid_argument);
+
+  denominators[11] = -1;
+  numerators[11] = std::numeric_limits<std::int32_t>::min();
+
+  EXPECT_THROW(reduceBatch(numerators.data(), denominators.data(), numerators.size()), std::overflow_error);
+
+  // The minimum as denominator can't be negated either
+  numerators[11] = 1;
+  denominators[11] = std::numeric_limits<std::int32_t>::min();
+
+  EXPECT_THROW(reduceBatch(numerators.data(), denominators.data(), numerators.size()), std::overflow_error);
+
+  // Reduced first, it fits
+  numerators[11] = 2;
+
+  reduceBatch(numerators.data(), denominators.data(), numerators.size());
+
+  EXPECT_EQ(-1, numerators[11]);
+  EXPECT_EQ(std::int32_t{1} << 30, denominators[11]);
+}
+
+namespace {
+/// Random fraction with a small denominator, so the exact reference sums can't overflow
+fraction_t nextSmallFraction() {
+  const std::int64_t numerator{nextInt32() % 10'000};
+  const std::int64_t denominator{1 + (nextUint32() % 24)};
+
+  return fraction_t{numerator, (nextUint32() % 2 == 0) ? denominator : -denominator};
+}
+
+/// Compares a kernel for @c fraction32_t against the reference in @c fraction_t, which must throw if it doesn't fit
+template <class KERNEL>
+void expectNarrowResult(const fraction_t& expected, KERNEL kernel, std::size_t caseNr) {
+  if (details::fitsInto<std::int32_t>(expected.getNumerator()) &&
+      details::fitsInto<std::int32_t>(expected.getDenominator())) {
+    EXPECT_EQ(fraction32_t(expected), kernel()) << "Case: " << caseNr;
+  } else {
+    EXPECT_THROW(kernel(), std::overflow_error) << "Case: " << caseNr;
+  }
+}
+}  // namespace
+
+TEST(TEST_CASE_NAME, fractionSum) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x95a11cd6};
+
+  runTest(
+      [](std::size_t caseNr) {
+        constexpr std::size_t count{16};
+
+        std::vector<fraction_t> values;
+        std::vector<fraction32_t> narrowValues;
+        fraction_t expected{};
+
+        for (std::size_t i = 0; i < count; ++i) {
+          values.push_back(nextSmallFraction());
+          narrowValues.emplace_back(values.back());
+          expected += values.back();
+        }
+
+        EXPECT_EQ(expected, fractionSum(values.data(), count)) << "Case: " << caseNr;
+        expectNarrowResult(
+            expected, [&]() { return fractionSum(narrowValues.data(), count); }, caseNr);
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, fractionDot) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x527ad1d1};
+
+  runTest(
+      [](std::size_t caseNr) {
+        constexpr std::size_t count{8};
+
+        std::vector<fraction_t> lhs;
+        std::vector<fraction_t> rhs;
+        std::vector<fraction32_t> narrowLhs;
+        std::vector<fraction32_t> narrowRhs;
+        fraction_t expected{};
+
+        for (std::size_t i = 0; i < count; ++i) {
+          lhs.push_back(nextSmallFraction());
+          rhs.push_back(nextSmallFraction());
+          narrowLhs.emplace_back(lhs.back());
+          narrowRhs.emplace_back(rhs.back());
+          expected += lhs.back() * rhs.back();
+        }
+
+        EXPECT_EQ(expected, fractionDot(lhs.data(), rhs.data(), count)) << "Case: " << caseNr;
+        expectNarrowResult(
+            expected, [&]() { return fractionDot(narrowLhs.data(), narrowRhs.data(), count); }, caseNr);
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, fractionAxpy) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x52b3baaf};
+
+  runTest(
+      [](std::size_t caseNr) {
+        constexpr std::size_t count{8};
+
+        const fraction_t factor{nextSmallFraction()};
+        std::vector<fraction_t> x;
+        std::vector<fraction_t> y;
+
+        for (std::size_t i = 0; i < count; ++i) {
+          x.push_back(nextSmallFraction());
+          y.push_back(nextSmallFraction());
+        }
+
+        std::vector<fraction_t> actual{y};
+
+        fractionAxpy(factor, x.data(), actual.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i)
+          EXPECT_EQ(factor * x[i] + y[i], actual[i]) << "Case: " << caseNr << ", Index: " << i;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, floatingPointConversion) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xb657e02b};
+
+  runTest(
+      [](std::size_t caseNr) {
+        // Not a multiple of the vector width, so the scalar tail is covered as well
+        constexpr std::size_t count{19};
+
+        std::vector<double> values(count);
+
+        // Ratios of small integers, integers, negative values and values the vector loop has to leave to the scalar one
+        for (std::size_t i = 0; i < count; ++i) {
+          const double numerator{static_cast<double>(nextInt32() % 100'000)};
+
+          switch (i % 4) {
+            case 0:
+              values[i] = numerator / static_cast<double>(1 + nextUint32() % 1000);
+              break;
+            case 1:
+              values[i] = numerator;
+              break;
+            case 2:
+              values[i] = static_cast<double>(nextInt32() / 2) / static_cast<double>(nextInt32NoZero());
+              break;
+            default:
+              values[i] = numerator * 1e4;
+              break;
+          }
+        }
+
+        std::vector<fraction32_t> actual(count);
+        std::vector<fraction_t> wideActual(count);
+        std::vector<double> roundTrip(count);
+        std::vector<double> wideRoundTrip(count);
+
+        for (const double precision : {0.0, 1e-6}) {
+          fromFloatingPointBatch(values.data(), actual.data(), count, precision);
+          fromFloatingPointBatch(values.data(), wideActual.data(), count, precision);
+
+          for (std::size_t i = 0; i < count; ++i) {
+            const fraction32_t expected{values[i], precision};
+
+            EXPECT_EQ(expected.getNumerator(), actual[i].getNumerator()) << "Case: " << caseNr << ", Index: " << i;
+            EXPECT_EQ(expected.getDenominator(), actual[i].getDenominator()) << "Case: " << caseNr << ", Index: " << i;
+            EXPECT_EQ(fraction_t(values[i], precision), wideActual[i]) << "Case: " << caseNr << ", Index: " << i;
+          }
+        }
+
+        toFloatingPointBatch(actual.data(), roundTrip.data(), count);
+        toFloatingPointBatch(wideActual.data(), wideRoundTrip.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+          EXPECT_EQ(static_cast<double>(actual[i]), roundTrip[i]) << "Case: " << caseNr << ", Index: " << i;
+          EXPECT_EQ(static_cast<double>(wideActual[i]), wideRoundTrip[i]) << "Case: " << caseNr << ", Index: " << i;
+        }
+
+        limitDenominatorBatch(values.data(), actual.data(), count, 1000);
+
+        for (std::size_t i = 0; i < count; ++i) {
+          EXPECT_EQ(fraction32_t::limitDenominator(values[i], 1000), actual[i])
+              << "Case: " << caseNr << ", Index: " << i;
+        }
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, floatingPointConversionExceptions) {
+  std::vector<double> values(9, 0.5);
+  std::vector<fraction32_t> fractions(9);
+  std::vector<ufraction32_t> unsignedFractions(9);
+
+  values[5] = std::numeric_limits<double>::quiet_NaN();
+
+  EXPECT_THROW(fromFloatingPointBatch(values.data(), fractions.data(), values.size()), std::invalid_argument);
+  EXPECT_EQ(fraction32_t(1, 2), fractions[4]);
+
+  values[5] = 3e9;
+
+  EXPECT_THROW(fromFloatingPointBatch(values.data(), fractions.data(), values.size()), std::overflow_error);
+  EXPECT_NO_THROW(fromFloatingPointBatch(values.data(), unsignedFractions.data(), values.size()));
+  EXPECT_EQ(ufraction32_t(3'000'000'000u), unsignedFractions[5]);
+
+  values[5] = -0.5;
+
+  EXPECT_THROW(fromFloatingPointBatch(values.data(), unsignedFractions.data(), values.size()), std::invalid_argument);
+  EXPECT_THROW(limitDenominatorBatch(values.data(), fractions.data(), values.size(), 0), std::invalid_argument);
+}
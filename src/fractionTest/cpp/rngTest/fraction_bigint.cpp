@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+#include "rngTest/rngUtils.hpp"
+
+#define TEST_CASE_NAME RNGTest_fraction_bigint
+
+namespace {
+/// Random value of up to 256 bits, so every division path gets hit
+bigint nextBigint() {
+  bigint value{nextInt64()};
+
+  for (std::uint32_t limbs = nextUint32() % 4; limbs > 0; --limbs) value = (value * bigint{nextUint64()}) + nextInt32();
+
+  return value;
+}
+}  // namespace
+
+TEST(TEST_CASE_NAME, arithmetic) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x26e81680};
+
+  runTest(
+      [](std::size_t caseNr) {
+        // Products of 64 bit values can be checked limb by limb against 32 bit halves
+        const std::int64_t lhs{nextInt32()};
+        const std::int64_t rhs{nextInt32NoZero()};
+
+        EXPECT_EQ(bigint{lhs + rhs}, bigint{lhs} + bigint{rhs}) << "Case: " << caseNr;
+        EXPECT_EQ(bigint{lhs - rhs}, bigint{lhs} - bigint{rhs}) << "Case: " << caseNr;
+        EXPECT_EQ(bigint{lhs * rhs}, bigint{lhs} * bigint{rhs}) << "Case: " << caseNr;
+        EXPECT_EQ(bigint{lhs / rhs}, bigint{lhs} / bigint{rhs}) << "Case: " << caseNr;
+        EXPECT_EQ(bigint{lhs % rhs}, bigint{lhs} % bigint{rhs}) << "Case: " << caseNr;
+
+        const bigint value{nextBigint()};
+
+        EXPECT_EQ(value, bigint{value.toString()}) << "Case: " << caseNr;
+        EXPECT_EQ(value, (value + value) - value) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, divisionIdentity) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x335190b7};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const bigint lhs{nextBigint()};
+        bigint rhs{nextBigint()};
+
+        if (rhs.isZero()) rhs = bigint{1};
+
+        bigint quotient;
+        bigint remainder;
+
+        bigint::divide(lhs, rhs, quotient, remainder);
+
+        const bigint absRemainder{remainder.isNegative() ? -remainder : remainder};
+        const bigint absRhs{rhs.isNegative() ? -rhs : rhs};
+
+        EXPECT_EQ(lhs, (quotient * rhs) + remainder) << "Case: " << caseNr;
+        EXPECT_LT(absRemainder, absRhs) << "Case: " << caseNr;
+        EXPECT_TRUE(remainder.isZero() || (remainder.isNegative() == lhs.isNegative())) << "Case: " << caseNr;
+        EXPECT_EQ(lhs, (lhs * rhs) / rhs) << "Case: " << caseNr;
+
+        const bigint gcd{bigint::gcd(lhs, rhs)};
+
+        EXPECT_TRUE((lhs % gcd).isZero()) << "Case: " << caseNr;
+        EXPECT_TRUE((rhs % gcd).isZero()) << "Case: " << caseNr;
+        EXPECT_EQ(bigint{1}, bigint::gcd(lhs / gcd, rhs / gcd)) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, fractionArithmetic) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xc96cc064};
+
+  runTest(
+      [](std::size_t caseNr) {
+        // 32 bit fractions don't overflow 64 bit ones, so those are the reference
+        const fraction_t lhs{nextInt32(), nextInt32NoZero()};
+        const fraction_t rhs{nextInt32(), nextInt32NoZero()};
+        const fraction_bigint_t bigLhs{lhs};
+        const fraction_bigint_t bigRhs{rhs};
+
+        EXPECT_EQ(lhs * rhs, (bigLhs * bigRhs).toFraction<std::int64_t>()) << "Case: " << caseNr;
+        EXPECT_EQ(lhs / rhs, (bigLhs / bigRhs).toFraction<std::int64_t>()) << "Case: " << caseNr;
+        EXPECT_EQ(lhs < rhs, bigLhs < bigRhs) << "Case: " << caseNr;
+        EXPECT_EQ(lhs == rhs, bigLhs == bigRhs) << "Case: " << caseNr;
+
+        // Sums of 64 bit fractions can overflow, but subtracting again has to give the exact value back
+        const fraction_t wideLhs{nextInt64(), nextInt64NoZero()};
+        const fraction_t wideRhs{nextInt64(), nextInt64NoZero()};
+        const fraction_bigint_t sum{fraction_bigint_t{wideLhs} + wideRhs};
+
+        EXPECT_EQ(wideLhs, (sum - wideRhs).toFraction<std::int64_t>()) << "Case: " << caseNr;
+        EXPECT_EQ(fraction_bigint_t{wideLhs}, (fraction_bigint_t{wideLhs} * wideRhs) / wideRhs) << "Case: " << caseNr;
+      },
+      seed);
+}
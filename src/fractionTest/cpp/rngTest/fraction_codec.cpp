@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+#include "rngTest/rngUtils.hpp"
+
+#define TEST_CASE_NAME RNGTest_fraction_codec
+
+TEST(TEST_CASE_NAME, roundTrip) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xd175c773};
+
+  runTest(
+      [](std::size_t caseNr) {
+        // Shifting spreads the values over all encoded sizes
+        const auto nextShifted = [](auto value) { return value >> (nextUint32() % 64); };
+
+        const std::vector<fraction_t> values{{nextShifted(nextInt64())},
+                                             {nextShifted(nextInt64()), nextShifted(nextInt64NoZero()) | 1},
+                                             {nextInt64(), nextInt64NoZero()}};
+        const std::vector<ufraction_t> unsignedValues{{nextShifted(nextUint64()), nextShifted(nextUint64NoZero()) | 1},
+                                                      {nextUint64()}};
+
+        std::vector<unsigned char> buffer(fraction_codec_t::maxBlockSize(values.size()));
+        std::vector<fraction_t> actual;
+        const unsigned char* end{fraction_codec_t::encodeBlock(values.data(), values.size(), buffer.data())};
+
+        EXPECT_EQ(end, fraction_codec_t::decodeBlock(buffer.data(), end, actual)) << "Case: " << caseNr;
+        EXPECT_EQ(values, actual) << "Case: " << caseNr;
+
+        std::vector<ufraction_t> unsignedActual(unsignedValues.size());
+        end = ufraction_codec_t::encode(unsignedValues.data(), unsignedValues.size(), buffer.data());
+
+        EXPECT_EQ(end, ufraction_codec_t::decode(buffer.data(), end, unsignedActual.data(), unsignedActual.size()))
+            << "Case: " << caseNr;
+        EXPECT_EQ(unsignedValues, unsignedActual) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, corruptBlock) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x49209a51};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const std::vector<fraction_t> values{{nextInt32(), nextInt32NoZero()}, {nextInt64(), nextInt64NoZero()}};
+        std::vector<unsigned char> buffer(fraction_codec_t::maxBlockSize(values.size()));
+        const unsigned char* const end{fraction_codec_t::encodeBlock(values.data(), values.size(), buffer.data())};
+        const std::size_t size{static_cast<std::size_t>(end - buffer.data())};
+
+        // The CRC-32 detects every single bit error
+        buffer[nextUint32() % size] ^= static_cast<unsigned char>(1U << (nextUint32() % 8));
+
+        std::vector<fraction_t> actual;
+
+        EXPECT_ANY_THROW(fraction_codec_t::decodeBlock(buffer.data(), end, actual)) << "Case: " << caseNr;
+        EXPECT_TRUE(actual.empty()) << "Case: " << caseNr;
+      },
+      seed);
+}
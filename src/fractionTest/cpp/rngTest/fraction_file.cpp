@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+#include "rngTest/rngUtils.hpp"
+
+#define TEST_CASE_NAME RNGTest_fraction_file
+
+TEST(TEST_CASE_NAME, mappedRoundTrip) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x8a4db31a};
+
+  const std::string path{"RNGTest_fraction_file_mappedRoundTrip.frac"};
+  std::vector<fraction_t> values;
+  std::vector<std::int64_t> numerators;
+  std::vector<std::int64_t> denominators;
+
+  // Writing a file per case would take ages, so the cases only collect the fractions
+  runTest(
+      [&](std::size_t) {
+        const std::int64_t numerator{nextInt32()};
+        const std::int64_t denominator{(nextInt32NoZero() & 0x7FFFFFFF) | 1};
+        const std::int64_t factor{(nextUint32() % 1000) + 1};
+
+        values.emplace_back(numerator, denominator);
+        numerators.push_back(numerator * factor);
+        denominators.push_back(denominator * factor);
+      },
+      seed);
+
+  writeFractionFile(path, values.data(), values.size(), 1000);
+
+  {
+    const fraction_file_t file{path};
+
+    ASSERT_EQ(values.size(), file.size());
+    EXPECT_TRUE(file.allReduced());
+
+    for (std::size_t caseNr = 0; caseNr < values.size(); ++caseNr) {
+      EXPECT_EQ(values[caseNr].getNumerator(), file.numerators()[caseNr]) << "Case: " << caseNr;
+      EXPECT_EQ(values[caseNr].getDenominator(), file.denominators()[caseNr]) << "Case: " << caseNr;
+      EXPECT_EQ(values[caseNr], file[caseNr]) << "Case: " << caseNr;
+    }
+  }
+
+  writeFractionFile(path, numerators.data(), denominators.data(), numerators.size());
+
+  {
+    const fraction_file_t file{path};
+
+    ASSERT_EQ(values.size(), file.size());
+    EXPECT_FALSE(file.allReduced());
+    EXPECT_TRUE(std::equal(numerators.begin(), numerators.end(), file.numerators().begin()));
+
+    for (std::size_t caseNr = 0; caseNr < values.size(); ++caseNr)
+      EXPECT_EQ(values[caseNr], file[caseNr]) << "Case: " << caseNr;
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(TEST_CASE_NAME, blockSummaries) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xd65b1814};
+  constexpr std::size_t blockSize{999};
+
+  const std::string path{"RNGTest_fraction_file_blockSummaries.frac"};
+  fraction_vector32_t values;
+
+  runTest([&](std::size_t) { values.push_back(fraction32_t{nextInt32(), nextInt32NoZero()}); }, seed);
+
+  writeFractionFile(path, values, blockSize);
+
+  const fraction_file32_t file{path};
+
+  ASSERT_EQ(values.size(), file.size());
+  ASSERT_EQ((values.size() + blockSize - 1) / blockSize, file.blockCount());
+
+  for (std::size_t block = 0; block < file.blockCount(); ++block) {
+    const std::size_t begin{block * blockSize};
+    const std::size_t end{std::min(begin + blockSize, values.size())};
+    fraction32_t min{values[begin]};
+    fraction32_t max{values[begin]};
+
+    for (std::size_t i = begin; i < end; ++i) {
+      min = std::min<fraction32_t>(min, values[i]);
+      max = std::max<fraction32_t>(max, values[i]);
+    }
+
+    EXPECT_EQ(min, file.blockMin(block)) << "Block: " << block;
+    EXPECT_EQ(max, file.blockMax(block)) << "Block: " << block;
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(TEST_CASE_NAME, invalidFile) {
+  const std::string path{"RNGTest_fraction_file_invalidFile.frac"};
+  const std::vector<fraction_t> values{{1, 2}, {-3, 4}};
+  const std::int64_t numerators[]{1, 2};
+  const std::int64_t denominators[]{1, 0};
+
+  writeFractionFile(path, values.data(), values.size());
+
+  EXPECT_THROW(fraction_file32_t{path}, std::invalid_argument);
+  EXPECT_THROW(fraction_file<std::uint64_t>{path}, std::invalid_argument);
+  EXPECT_THROW(writeFractionFile(path, numerators, denominators, 2), std::invalid_argument);
+  EXPECT_THROW(writeFractionFile(path, values.data(), values.size(), 0), std::invalid_argument);
+
+  // Cuts the file off after 100 bytes
+  {
+    char start[100]{};
+
+    std::ifstream{path, std::ios_base::binary}.read(start, sizeof(start));
+    std::ofstream{path, std::ios_base::binary | std::ios_base::trunc}.write(start, sizeof(start));
+  }
+
+  EXPECT_THROW(fraction_file_t{path}, std::invalid_argument);
+
+  std::remove(path.c_str());
+
+  EXPECT_THROW(fraction_file_t{path}, std::runtime_error);
+}
+
+TEST(TEST_CASE_NAME, untrustedFile) {
+  const std::string path{"RNGTest_fraction_file_untrustedFile.frac"};
+  const std::int64_t numerators[]{0, 0};
+  const std::int64_t denominators[]{5, 1};
+
+  // A zero numerator is only reduced over a denominator of 1
+  writeFractionFile(path, numerators, denominators, 2);
+
+  {
+    const fraction_file_t file{path};
+
+    EXPECT_FALSE(file.allReduced());
+    EXPECT_EQ(fraction_t(0), file[0]);
+    EXPECT_EQ(1, file[0].getDenominator());
+  }
+
+  // A block size close to 2^64 still has to give one block that covers the whole file
+  {
+    const std::uint64_t blockSize{std::numeric_limits<std::uint64_t>::max()};
+    std::fstream stream{path, std::ios_base::binary | std::ios_base::in | std::ios_base::out};
+
+    stream.seekp(32);
+    stream.write(reinterpret_cast<const char*>(&blockSize), sizeof(blockSize));
+  }
+
+  {
+    const fraction_file_t file{path};
+
+    EXPECT_EQ(1U, file.blockCount());
+    EXPECT_EQ(fraction_t(0), file.blockMin(0));
+  }
+
+  const std::vector<fraction_t> values{{1, 2}};
+
+  writeFractionFile(path, values.data(), values.size());
+
+  // Changes the stored fraction behind the back of the reduced flag and the block summary
+  const auto patch = [&path](std::int64_t numerator, std::int64_t denominator) {
+    std::fstream stream{path, std::ios_base::binary | std::ios_base::in | std::ios_base::out};
+
+    stream.seekp(64);
+    stream.write(reinterpret_cast<const char*>(&numerator), sizeof(numerator));
+    stream.seekp(128);
+    stream.write(reinterpret_cast<const char*>(&denominator), sizeof(denominator));
+    stream.seekp(192);
+    stream.write(reinterpret_cast<const char*>(&numerator), sizeof(numerator));
+    stream.write(reinterpret_cast<const char*>(&denominator), sizeof(denominator));
+  };
+
+  patch(2, 4);
+
+  {
+    const fraction_file_t file{path};
+
+    EXPECT_TRUE(file.allReduced());
+    EXPECT_EQ(fraction_t(1, 2), file[0]);
+    EXPECT_EQ(fraction_t(1, 2), file.blockMin(0));
+  }
+
+  patch(-1, -2);
+
+  {
+    const fraction_file_t file{path};
+
+    EXPECT_EQ(fraction_t(1, 2), file[0]);
+    EXPECT_EQ(2, file.blockMin(0).getDenominator());
+  }
+
+  patch(1, 0);
+
+  {
+    const fraction_file_t file{path};
+
+    EXPECT_THROW(file[0], std::invalid_argument);
+    EXPECT_THROW(file.blockMin(0), std::invalid_argument);
+  }
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+#include "rngTest/rngUtils.hpp"
+
+#define TEST_CASE_NAME RNGTest_fraction_pool
+
+TEST(TEST_CASE_NAME, intern) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x081d29b9};
+
+  fraction_pool_t pool;
+  std::unordered_map<fraction_t, fraction_pool_t::handle_type> handles;
+
+  runTest(
+      [&](std::size_t caseNr) {
+        // Few distinct values, so most of them are interned more than once
+        const fraction_t val{static_cast<std::int64_t>(nextUint32() % 200) - 100,
+                             static_cast<std::int64_t>(nextUint32() % 50) + 1};
+        const fraction_pool_t::handle_type handle{pool.intern(val)};
+        const auto inserted = handles.emplace(val, handle);
+
+        EXPECT_EQ(inserted.first->second, handle) << "Case: " << caseNr;
+        EXPECT_EQ(val, pool[handle]) << "Case: " << caseNr;
+        EXPECT_EQ(val, pool.at(handle)) << "Case: " << caseNr;
+      },
+      seed);
+
+  EXPECT_EQ(handles.size(), pool.size());
+
+  // Distinct values got distinct handles
+  std::unordered_map<fraction_pool_t::handle_type, fraction_t> values;
+
+  for (const auto& entry : handles) EXPECT_TRUE(values.emplace(entry.second, entry.first).second);
+
+  fraction_pool32_t emptyPool;
+
+  EXPECT_THROW(emptyPool.at(0), std::out_of_range);
+  EXPECT_THROW(emptyPool.at(pool.intern(fraction_t{1, 2})), std::out_of_range);
+}
+
+TEST(TEST_CASE_NAME, operations) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xba19a09a};
+
+  // The small cache makes sure entries get replaced too
+  fraction_pool32_t pool{64};
+  std::vector<fraction_pool32_t::handle_type> handles;
+
+  for (std::int32_t i = -10; i <= 10; ++i) handles.push_back(pool.intern(fraction32_t{i, (i & 7) + 1}));
+
+  runTest(
+      [&](std::size_t caseNr) {
+        const fraction_pool32_t::handle_type lhs{handles[nextUint32() % handles.size()]};
+        const fraction_pool32_t::handle_type rhs{handles[nextUint32() % handles.size()]};
+
+        for (int repeat = 0; repeat < 2; ++repeat) {
+          EXPECT_EQ(pool[lhs] + pool[rhs], pool[pool.add(lhs, rhs)]) << "Case: " << caseNr;
+          EXPECT_EQ(pool[lhs] - pool[rhs], pool[pool.subtract(lhs, rhs)]) << "Case: " << caseNr;
+          EXPECT_EQ(pool[lhs] * pool[rhs], pool[pool.multiply(lhs, rhs)]) << "Case: " << caseNr;
+
+          if (pool[rhs] == fraction32_t{0})
+            EXPECT_THROW(pool.divide(lhs, rhs), std::invalid_argument) << "Case: " << caseNr;
+          else
+            EXPECT_EQ(pool[lhs] / pool[rhs], pool[pool.divide(lhs, rhs)]) << "Case: " << caseNr;
+        }
+
+        EXPECT_EQ(pool.add(lhs, rhs), pool.intern(pool[lhs] + pool[rhs])) << "Case: " << caseNr;
+      },
+      seed);
+
+  EXPECT_EQ(64U, pool.cacheSize());
+  EXPECT_EQ(0U, fraction_pool32_t{0}.cacheSize());
+  EXPECT_THROW(fraction_pool32_t{std::numeric_limits<std::size_t>::max()}, std::length_error);
+}
+
+TEST(TEST_CASE_NAME, concurrentIntern) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x655c6efb};
+  constexpr std::size_t threadCount{4};
+
+  fraction_pool_t pool;
+  std::vector<fraction_t> values;
+
+  // The rng isn't thread safe, so the values are drawn up front
+  runTest([&](std::size_t) { values.emplace_back(static_cast<std::int64_t>(nextUint32() % 1000), nextInt32NoZero()); },
+          seed);
+
+  std::vector<std::vector<fraction_pool_t::handle_type>> handles(threadCount);
+  std::vector<std::thread> threads;
+
+  for (std::size_t thread = 0; thread < threadCount; ++thread) {
+    threads.emplace_back([&pool, &values, &threadHandles = handles[thread]]() {
+      for (const fraction_t& val : values) threadHandles.push_back(pool.intern(val));
+    });
+  }
+
+  for (std::thread& thread : threads) thread.join();
+
+  for (std::size_t caseNr = 0; caseNr < values.size(); ++caseNr) {
+    EXPECT_EQ(values[caseNr], pool[handles[0][caseNr]]) << "Case: " << caseNr;
+
+    for (std::size_t thread = 1; thread < threadCount; ++thread)
+      EXPECT_EQ(handles[0][caseNr], handles[thread][caseNr]) << "Case: " << caseNr;
+  }
+}
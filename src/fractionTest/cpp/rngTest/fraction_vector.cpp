@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2018 Yannick Schinko
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+//
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "defines.hpp"
+#include "rngTest/rngUtils.hpp"
+
+#define TEST_CASE_NAME RNGTest_fraction_vector
+
+TEST(TEST_CASE_NAME, elementWiseOperations) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xa2f1d6d0};
+
+  runTest(
+      [](std::size_t caseNr) {
+        constexpr std::size_t count{19};
+
+        std::vector<fraction_t> values1;
+        std::vector<fraction_t> values2;
+        fraction_vector_t vector1;
+        fraction_vector_t vector2;
+
+        for (std::size_t i = 0; i < count; ++i) {
+          values1.emplace_back(nextInt32(), nextInt32NoZero());
+          values2.emplace_back(nextInt32NoZero(), nextInt32NoZero());
+
+          vector1.push_back(values1.back());
+          vector2.push_back(values2.back());
+        }
+
+        const fraction_t scalar{nextInt32NoZero(), nextInt32NoZero()};
+
+        const fraction_vector_t sum{vector1 + vector2};
+        const fraction_vector_t difference{vector1 - vector2};
+        const fraction_vector_t product{vector1 * vector2};
+        const fraction_vector_t quotient{vector1 / vector2};
+        const fraction_vector_t scaled{vector1 * scalar};
+
+        for (std::size_t i = 0; i < count; ++i) {
+          EXPECT_EQ(values1[i] + values2[i], sum[i]) << "Case: " << caseNr << ", Index: " << i;
+          EXPECT_EQ(values1[i] - values2[i], difference[i]) << "Case: " << caseNr << ", Index: " << i;
+          EXPECT_EQ(values1[i] * values2[i], product[i]) << "Case: " << caseNr << ", Index: " << i;
+          EXPECT_EQ(values1[i] / values2[i], quotient[i]) << "Case: " << caseNr << ", Index: " << i;
+          EXPECT_EQ(values1[i] * scalar, scaled[i]) << "Case: " << caseNr << ", Index: " << i;
+        }
+      },
+      seed);
+}
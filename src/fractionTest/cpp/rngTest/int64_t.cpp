@@ -2,6 +2,14 @@
 // Copyright (c) 2018 Yannick Schinko
 // Licensed under the MIT License. See LICENSE file in the project root for full license information.
 //
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "defines.hpp"
@@ -188,3 +196,422 @@ TEST(TEST_CASE_NAME, greaterThanOrEquals) {
       },
       seed);
 }
+
+TEST(TEST_CASE_NAME, reduction) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x9477e24c};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const std::int64_t factor{nextInt32NoZero()};
+        const std::int64_t numerator{nextInt32NoZero()};
+        const std::int64_t denominator{nextInt32NoZero()};
+
+        const fraction_t val{numerator * factor, denominator * factor};
+
+        EXPECT_EQ(1, std::gcd(val.getNumerator(), val.getDenominator())) << "Case: " << caseNr;
+        EXPECT_EQ(numerator * val.getDenominator(), denominator * val.getNumerator()) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, addition) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x2b2ae874};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const fraction32_t val1{nextInt32(), nextInt32NoZero()};
+        const fraction32_t val2{nextInt32(), nextInt32NoZero()};
+
+        // All products fit into 64 bits, so the naive result is exact
+        const fraction_t expected{(std::int64_t{val1.getNumerator()} * val2.getDenominator()) +
+                                      (std::int64_t{val2.getNumerator()} * val1.getDenominator()),
+                                  std::int64_t{val1.getDenominator()} * val2.getDenominator()};
+
+        EXPECT_EQ(expected, fraction_t{val1} + fraction_t{val2}) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, subtraction) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x8dbc6b79};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const fraction32_t val1{nextInt32(), nextInt32NoZero()};
+        const fraction32_t val2{nextInt32(), nextInt32NoZero()};
+
+        // All products fit into 64 bits, so the naive result is exact
+        const fraction_t expected{(std::int64_t{val1.getNumerator()} * val2.getDenominator()) -
+                                      (std::int64_t{val2.getNumerator()} * val1.getDenominator()),
+                                  std::int64_t{val1.getDenominator()} * val2.getDenominator()};
+
+        EXPECT_EQ(expected, fraction_t{val1} - fraction_t{val2}) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, multiplication) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x98c94468};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const fraction32_t val1{nextInt32(), nextInt32NoZero()};
+        const fraction32_t val2{nextInt32(), nextInt32NoZero()};
+
+        // All products fit into 64 bits, so the naive result is exact
+        const fraction_t expected{std::int64_t{val1.getNumerator()} * val2.getNumerator(),
+                                  std::int64_t{val1.getDenominator()} * val2.getDenominator()};
+
+        EXPECT_EQ(expected, fraction_t{val1} * fraction_t{val2}) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, division) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x50c9b5e7};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const fraction32_t val1{nextInt32(), nextInt32NoZero()};
+        const fraction32_t val2{nextInt32NoZero(), nextInt32NoZero()};
+
+        // All products fit into 64 bits, so the naive result is exact
+        const fraction_t expected{std::int64_t{val1.getNumerator()} * val2.getDenominator(),
+                                  std::int64_t{val1.getDenominator()} * val2.getNumerator()};
+
+        EXPECT_EQ(expected, fraction_t{val1} / fraction_t{val2}) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, integerOperands) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xa23dcf65};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const fraction_t val{nextInt32(), nextInt32NoZero()};
+        const std::int64_t integer{nextInt32NoZero()};
+        const fraction_t integerFraction{integer};
+
+        EXPECT_EQ(val + integerFraction, val + integer) << "Case: " << caseNr;
+        EXPECT_EQ(integerFraction + val, integer + val) << "Case: " << caseNr;
+        EXPECT_EQ(val - integerFraction, val - integer) << "Case: " << caseNr;
+        EXPECT_EQ(integerFraction - val, integer - val) << "Case: " << caseNr;
+        EXPECT_EQ(val * integerFraction, val * integer) << "Case: " << caseNr;
+        EXPECT_EQ(integerFraction * val, integer * val) << "Case: " << caseNr;
+        EXPECT_EQ(val / integerFraction, val / integer) << "Case: " << caseNr;
+
+        if (val.getNumerator() != 0) {
+          EXPECT_EQ(integerFraction / val, integer / val) << "Case: " << caseNr;
+        }
+
+        EXPECT_EQ(val < integerFraction, val < integer) << "Case: " << caseNr;
+        EXPECT_EQ(integerFraction < val, integer < val) << "Case: " << caseNr;
+        EXPECT_EQ(val == integerFraction, val == integer) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, sharedDenominators) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xa0cdace3};
+
+  runTest(
+      [](std::size_t caseNr) {
+        // Small shared denominators, like cents or ticks, plus integer valued and zero operands
+        const std::int32_t denominator{static_cast<std::int32_t>(nextUint32() % 1000) + 1};
+        const std::int32_t numerator1{nextInt32()};
+        const std::int32_t numerator2{(caseNr % 8 == 0) ? 0 : nextInt32()};
+        const std::int32_t denominator2{(caseNr % 4 == 1) ? 1 : denominator};
+
+        const fraction32_t val1{numerator1, denominator};
+        const fraction32_t val2{numerator2, denominator2};
+
+        // All products fit into 64 bits, so the naive results are exact
+        const std::int64_t crossProduct1{std::int64_t{val1.getNumerator()} * val2.getDenominator()};
+        const std::int64_t crossProduct2{std::int64_t{val2.getNumerator()} * val1.getDenominator()};
+        const std::int64_t denominatorProduct{std::int64_t{val1.getDenominator()} * val2.getDenominator()};
+
+        EXPECT_EQ(fraction_t(crossProduct1 + crossProduct2, denominatorProduct), fraction_t{val1} + fraction_t{val2})
+            << "Case: " << caseNr;
+        EXPECT_EQ(fraction_t(crossProduct1 - crossProduct2, denominatorProduct), fraction_t{val1} - fraction_t{val2})
+            << "Case: " << caseNr;
+        EXPECT_EQ(fraction_t(crossProduct2 - crossProduct1, denominatorProduct), fraction_t{val2} - fraction_t{val1})
+            << "Case: " << caseNr;
+        EXPECT_EQ(fraction_t(std::int64_t{val1.getNumerator()} * val2.getNumerator(), denominatorProduct),
+                  fraction_t{val2} * fraction_t{val1})
+            << "Case: " << caseNr;
+        EXPECT_EQ(crossProduct1 < crossProduct2, fraction_t{val1} < fraction_t{val2}) << "Case: " << caseNr;
+        EXPECT_EQ(crossProduct2 < crossProduct1, fraction_t{val2} < fraction_t{val1}) << "Case: " << caseNr;
+
+        if (val2.getNumerator() != 0) {
+          EXPECT_EQ(fraction_t(crossProduct1, crossProduct2), fraction_t{val1} / fraction_t{val2})
+              << "Case: " << caseNr;
+        }
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, limitDenominator) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xc8bf3d00};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const fraction_t val{nextInt32(), nextInt32NoZero()};
+        const std::int64_t maxDenominator{static_cast<std::int64_t>(nextUint32() % 64) + 1};
+        const auto distance = [&val](const fraction_t& approximation) {
+          const fraction_t difference{approximation - val};
+
+          return (difference < 0) ? -difference : difference;
+        };
+
+        // Brute force: The best numerator for each denominator is the floor of val * denominator or the next one
+        fraction_t bestDistance{distance(fraction_t{0})};
+
+        for (std::int64_t denominator = 1; denominator <= maxDenominator; ++denominator) {
+          const fraction_t scaled{val * denominator};
+          std::int64_t floor{scaled.getNumerator() / scaled.getDenominator()};
+
+          if ((scaled.getNumerator() % scaled.getDenominator() != 0) && (scaled.getNumerator() < 0)) --floor;
+
+          for (std::int64_t numerator = floor; numerator <= floor + 1; ++numerator) {
+            const fraction_t current{distance(fraction_t{numerator, denominator})};
+
+            if (current < bestDistance) bestDistance = current;
+          }
+        }
+
+        const fraction_t actual{val.limitDenominator(maxDenominator)};
+
+        EXPECT_LE(actual.getDenominator(), maxDenominator) << "Case: " << caseNr;
+        EXPECT_EQ(bestDistance, distance(actual)) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, limitDenominatorTies) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x092b69e0};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const std::int64_t maxDenominator{static_cast<std::int64_t>(nextUint32() % 16) + 1};
+        // Halfway between two fractions with the same denominator, so ties of either sign come up a lot
+        const fraction_t val{(2 * static_cast<std::int64_t>(nextInt32())) + 1,
+                             2 * ((static_cast<std::int64_t>(nextUint32()) % maxDenominator) + 1)};
+
+        // Reduced to a denominator that fits already
+        if (val.getDenominator() <= maxDenominator) {
+          EXPECT_EQ(val, val.limitDenominator(maxDenominator)) << "Case: " << caseNr;
+
+          return;
+        }
+
+        // Python's algorithm on the signed value, with floored division
+        std::int64_t p0{0};
+        std::int64_t q0{1};
+        std::int64_t p1{1};
+        std::int64_t q1{0};
+        std::int64_t numerator{val.getNumerator()};
+        std::int64_t denominator{val.getDenominator()};
+
+        while (true) {
+          std::int64_t digit{numerator / denominator};
+
+          if ((numerator % denominator) < 0) --digit;
+
+          const std::int64_t q2{q0 + (digit * q1)};
+
+          if (q2 > maxDenominator) break;
+
+          const std::int64_t p2{p0 + (digit * p1)};
+
+          p0 = p1;
+          q0 = q1;
+          p1 = p2;
+          q1 = q2;
+
+          const std::int64_t remainder{numerator - (digit * denominator)};
+
+          numerator = denominator;
+          denominator = remainder;
+        }
+
+        const std::int64_t steps{(maxDenominator - q0) / q1};
+        const fraction_t expected{(2 * denominator * (q0 + (steps * q1)) <= val.getDenominator())
+                                      ? fraction_t{p1, q1}
+                                      : fraction_t{p0 + (steps * p1), q0 + (steps * q1)}};
+
+        EXPECT_EQ(expected, val.limitDenominator(maxDenominator)) << "Case: " << caseNr;
+
+        // Only denominators that are powers of 2 survive the conversion to double unchanged
+        if ((val.getDenominator() & (val.getDenominator() - 1)) == 0) {
+          EXPECT_EQ(expected, fraction_t::limitDenominator(static_cast<double>(val), maxDenominator))
+              << "Case: " << caseNr;
+        }
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, toFloatingPoint) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x3a92616c};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const fraction_t val{nextInt64(), nextInt64NoZero()};
+
+        const double nearest{val.toFloatingPoint<double>()};
+        const double upward{val.toFloatingPoint<double>(std::round_toward_infinity)};
+        const double downward{val.toFloatingPoint<double>(std::round_toward_neg_infinity)};
+        const double towardZero{val.toFloatingPoint<double>(std::round_toward_zero)};
+
+        EXPECT_EQ(nearest, static_cast<double>(val)) << "Case: " << caseNr;
+        EXPECT_LE(downward, nearest) << "Case: " << caseNr;
+        EXPECT_LE(nearest, upward) << "Case: " << caseNr;
+        EXPECT_TRUE((downward == upward) || (std::nextafter(downward, upward) == upward)) << "Case: " << caseNr;
+        EXPECT_EQ((val < 0) ? upward : downward, towardZero) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, fromChars) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x3bd1f150};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const fraction_t val{nextInt64(), nextInt64NoZero()};
+        std::stringstream stream;
+
+        stream << val;
+
+        const std::string text{stream.str()};
+        fraction_t actual{};
+        const std::from_chars_result result{fraction_from_chars(text.data(), text.data() + text.size(), actual)};
+
+        EXPECT_EQ(std::errc{}, result.ec) << "Case: " << caseNr;
+        EXPECT_EQ(text.data() + text.size(), result.ptr) << "Case: " << caseNr;
+        EXPECT_EQ(val, actual) << "Case: " << caseNr;
+
+        // The same digits as a decimal with up to 9 digits after the point
+        const std::int64_t mantissa{nextInt64()};
+        const int fractionDigits{static_cast<int>(nextUint32() % 10)};
+        std::int64_t power{1};
+        std::string decimal{std::to_string(mantissa)};
+
+        for (int i = 0; i < fractionDigits; ++i) power *= 10;
+
+        if (fractionDigits > 0) {
+          const std::size_t sign{(mantissa < 0) ? std::size_t{1} : std::size_t{0}};
+
+          if (decimal.size() < (sign + static_cast<std::size_t>(fractionDigits)))
+            decimal.insert(sign, (sign + static_cast<std::size_t>(fractionDigits)) - decimal.size(), '0');
+
+          decimal.insert(decimal.size() - static_cast<std::size_t>(fractionDigits), 1, '.');
+        }
+
+        EXPECT_EQ(std::errc{}, fraction_from_chars(decimal.data(), decimal.data() + decimal.size(), actual).ec)
+            << "Case: " << caseNr;
+        EXPECT_EQ(fraction_t(mantissa, power), actual) << "Case: " << caseNr << ", " << decimal;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, toChars) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xd8fa68f5};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const fraction_t val{nextInt64(), nextInt64NoZero()};
+        char buffer[64];
+
+        for (const fraction_chars_format format : {fraction_chars_format::fraction, fraction_chars_format::compact}) {
+          const std::to_chars_result result{to_chars(buffer, buffer + sizeof(buffer), val, format)};
+          fraction_t actual{};
+
+          EXPECT_EQ(std::errc{}, result.ec) << "Case: " << caseNr;
+          EXPECT_EQ(std::errc{}, fraction_from_chars(buffer, result.ptr, actual).ec) << "Case: " << caseNr;
+          EXPECT_EQ(val, actual) << "Case: " << caseNr;
+        }
+
+        // The fixed digits are at most half a unit of the last place away
+        const fraction_t small{nextInt32(), nextInt32NoZero()};
+        const int precision{static_cast<int>(nextUint32() % 7)};
+        std::int64_t power{1};
+
+        for (int i = 0; i < precision; ++i) power *= 10;
+
+        const std::to_chars_result result{
+            to_chars(buffer, buffer + sizeof(buffer), small, fraction_chars_format::fixed, precision)};
+        fraction_t actual{};
+
+        EXPECT_EQ(std::errc{}, fraction_from_chars(buffer, result.ptr, actual).ec) << "Case: " << caseNr;
+
+        const fraction_t distance{(actual - small) * power};
+
+        EXPECT_LE(distance, fraction_t(1, 2)) << "Case: " << caseNr;
+        EXPECT_GE(distance, fraction_t(-1, 2)) << "Case: " << caseNr;
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, hash) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x0800fc57};
+
+  std::unordered_set<fraction_t, fraction_hash<>, fraction_equal_to<>> values;
+
+  runTest(
+      [&values](std::size_t caseNr) {
+        const fraction_t val{nextInt32(), nextInt32NoZero()};
+        const std::int64_t factor{(nextUint32() % 1000) + 1};
+        const lazy_fraction_t unreduced{val.getNumerator() * factor, val.getDenominator() * factor};
+
+        EXPECT_EQ(std::hash<fraction_t>{}(val), fraction_hash<>{}(unreduced)) << "Case: " << caseNr;
+        EXPECT_EQ(std::hash<fraction_t>{}(val), std::hash<lazy_fraction_t>{}(unreduced)) << "Case: " << caseNr;
+
+        values.insert(val);
+
+#ifdef __cpp_lib_generic_unordered_lookup
+        EXPECT_NE(values.end(), values.find(unreduced)) << "Case: " << caseNr;
+#endif
+      },
+      seed);
+}
+
+TEST(TEST_CASE_NAME, hashDistribution) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0xf9eebb79};
+  constexpr std::size_t bucketCount{64};
+
+  std::unordered_set<fraction_t> values;
+  std::unordered_set<std::size_t> hashes;
+  std::vector<std::size_t> buckets(bucketCount);
+
+  // Small numerators and denominators are the common case and the hardest one for a weak hash
+  runTest(
+      [&](std::size_t) {
+        const fraction_t val{static_cast<std::int64_t>(nextUint32() % 2000) - 1000,
+                             static_cast<std::int64_t>(nextUint32() % 1000) + 1};
+
+        if (values.insert(val).second) hashes.insert(std::hash<fraction_t>{}(val));
+      },
+      seed);
+
+  for (const fraction_t& val : values) ++buckets[std::hash<fraction_t>{}(val) % bucketCount];
+
+  // Only distinct fractions were hashed, so every collision is a flaw of the hash. The low bits select the bucket in
+  // power of two tables and have to be spread evenly too
+  EXPECT_EQ(values.size(), hashes.size());
+  EXPECT_LT(*std::max_element(buckets.begin(), buckets.end()), 2 * values.size() / bucketCount);
+  EXPECT_GT(*std::min_element(buckets.begin(), buckets.end()), values.size() / bucketCount / 2);
+}
@@ -2,6 +2,7 @@
 // Copyright (c) 2018 Yannick Schinko
 // Licensed under the MIT License. See LICENSE file in the project root for full license information.
 //
+#include <numeric>
 #include <sstream>
 
 #include <gtest/gtest.h>
@@ -190,3 +191,21 @@ TEST(TEST_CASE_NAME, greaterThanOrEquals) {
       },
       seed);
 }
+
+TEST(TEST_CASE_NAME, reduction) {
+  // First 4 bytes of MD5 hash of test name
+  constexpr seed_type seed{0x9477e24c};
+
+  runTest(
+      [](std::size_t caseNr) {
+        const std::uint64_t factor{nextUint32NoZero()};
+        const std::uint64_t numerator{nextUint32NoZero()};
+        const std::uint64_t denominator{nextUint32NoZero()};
+
+        const ufraction_t val{numerator * factor, denominator * factor};
+
+        EXPECT_EQ(1, std::gcd(val.getNumerator(), val.getDenominator())) << "Case: " << caseNr;
+        EXPECT_EQ(numerator * val.getDenominator(), denominator * val.getNumerator()) << "Case: " << caseNr;
+      },
+      seed);
+}
@@ -5,9 +5,34 @@
 #pragma once
 
 #include "fraction.hpp"
+#include "fraction_batch.hpp"
+#include "fraction_bigint.hpp"
+#include "fraction_codec.hpp"
+#include "fraction_file.hpp"
+#include "fraction_pool.hpp"
+#include "fraction_vector.hpp"
+#include "lazy_fraction.hpp"
 
 using fraction_t = fraction<std::int64_t>;
 using ufraction_t = fraction<std::uint64_t>;
 
 using fraction32_t = fraction<std::int32_t>;
 using ufraction32_t = fraction<std::uint32_t>;
+
+using fraction_bigint_t = fraction<bigint>;
+
+using lazy_fraction_t = lazy_fraction<std::int64_t>;
+using ulazy_fraction_t = lazy_fraction<std::uint64_t>;
+
+using fraction_vector_t = fraction_vector<std::int64_t>;
+using fraction_vector32_t = fraction_vector<std::int32_t>;
+
+using fraction_codec_t = fraction_codec<std::int64_t>;
+using ufraction_codec_t = fraction_codec<std::uint64_t>;
+using fraction_codec32_t = fraction_codec<std::int32_t>;
+
+using fraction_file_t = fraction_file<std::int64_t>;
+using fraction_file32_t = fraction_file<std::int32_t>;
+
+using fraction_pool_t = fraction_pool<std::int64_t>;
+using fraction_pool32_t = fraction_pool<std::int32_t>;